@@ -0,0 +1,306 @@
+/** @file       CRC.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  CRC16 (MSB first, CCITT by default) and CRC32 (reflected, IEEE 802.3 by default), with several kernels trading speed for memory:
+ *   - bitwise: no table, 8 iterations per byte;
+ *   - nibble: two 16 entries tables (32 bytes for CRC16, 64 bytes for CRC32), 2 lookups per byte. This is the default on the dsPIC;
+ *   - table: one 256 entries table, 1 lookup per byte;
+ *   - slicing-by-4 and by-8: 4 or 8 tables, processing 4 or 8 bytes per iteration with independent lookups. Only worth it on a host, with caches.
+ *  OGBWLIB_CRC_SLICES selects which kernels are compiled (and which tables are allocated), CRC16_update and CRC32_update use the fastest one.
+ *  The polynomials are set with CRC16_POLY and CRC32_POLY. The tables are computed at the first call of a kernel (if an interrupt calls it meanwhile, it computes them too, with the same result).
+ *
+ *  All the functions are incremental: start with CRC16_INIT (or CRC32_INIT), and give the data in as many parts as needed, each call returning the crc to pass to the next one.
+ *  CRC16_updateByteFIFO and CRC32_updateByteFIFO do it on the content of a ByteFIFO, whose data may be split in two parts by the end of its array.
+ *  Check values, on the 9 bytes "123456789": CRC16 0x29B1 (CRC-16/CCITT-FALSE), CRC32_final(crc) 0xCBF43926.
+ *  A CRC16 appended MSB first to the data gives a CRC16 of 0 on the whole.
+*/
+
+#include "../typedef.h"
+#include "CRC.h"
+
+static U16 crc16Nibble[16];
+static U32 crc32Nibble[16];
+static U8 nibbleReady;
+#if OGBWLIB_CRC_SLICES >= 1
+static U16 crc16Tables[OGBWLIB_CRC_SLICES][256];   // crc16Tables[k][b]: CRC of the byte b followed by k null bytes
+static U32 crc32Tables[OGBWLIB_CRC_SLICES][256];
+static U8 tablesReady;
+#endif
+
+static void initNibble(void) {
+    U8 i, j;
+    for(i = 0; i < 16; i++) {
+        U16 c16 = (U16)i << 12;
+        U32 c32 = i;
+        for(j = 0; j < 4; j++) {
+            c16 = (c16 & 0x8000) ? (c16 << 1) ^ CRC16_POLY : c16 << 1;
+            c32 = (c32 & 1) ? (c32 >> 1) ^ CRC32_POLY : c32 >> 1;
+        }
+        crc16Nibble[i] = c16;
+        crc32Nibble[i] = c32;
+    }
+    nibbleReady = 1;
+}
+
+#if OGBWLIB_CRC_SLICES >= 1
+static void initTables(void) {
+    U16 i;
+    U8 j, k;
+    for(i = 0; i < 256; i++) {
+        U16 c16 = i << 8;
+        U32 c32 = i;
+        for(j = 0; j < 8; j++) {
+            c16 = (c16 & 0x8000) ? (c16 << 1) ^ CRC16_POLY : c16 << 1;
+            c32 = (c32 & 1) ? (c32 >> 1) ^ CRC32_POLY : c32 >> 1;
+        }
+        crc16Tables[0][i] = c16;
+        crc32Tables[0][i] = c32;
+    }
+    for(k = 1; k < OGBWLIB_CRC_SLICES; k++) {
+        for(i = 0; i < 256; i++) {
+            U16 c16 = crc16Tables[k - 1][i];
+            U32 c32 = crc32Tables[k - 1][i];
+            crc16Tables[k][i] = (c16 << 8) ^ crc16Tables[0][c16 >> 8];
+            crc32Tables[k][i] = (c32 >> 8) ^ crc32Tables[0][c32 & 0xFF];
+        }
+    }
+    tablesReady = 1;
+}
+#endif
+
+/**
+ * CRC16, bitwise kernel (no table).
+ * @param crc   CRC16_INIT, or the value returned for the previous data
+ * @param data  data
+ * @param size  number of bytes
+ * @return      CRC16 of all the data given so far
+ */
+U16 CRC16_updateBitwise(U16 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    U8 j;
+    while(size--) {
+        crc ^= (U16)*p++ << 8;
+        for(j = 0; j < 8; j++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ CRC16_POLY : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * CRC16, nibble kernel (32 bytes table). Same parameters as CRC16_updateBitwise.
+ */
+U16 CRC16_updateNibble(U16 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!nibbleReady) {
+        initNibble();
+    }
+    while(size--) {
+        U8 b = *p++;
+        crc = (crc << 4) ^ crc16Nibble[(crc >> 12) ^ (b >> 4)];
+        crc = (crc << 4) ^ crc16Nibble[(crc >> 12) ^ (b & 0x0F)];
+    }
+    return crc;
+}
+
+#if OGBWLIB_CRC_SLICES >= 1
+/**
+ * CRC16, byte table kernel (512 bytes table). Same parameters as CRC16_updateBitwise.
+ */
+U16 CRC16_updateTable(U16 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!tablesReady) {
+        initTables();
+    }
+    while(size--) {
+        crc = (crc << 8) ^ crc16Tables[0][(crc >> 8) ^ *p++];
+    }
+    return crc;
+}
+#endif
+
+#if OGBWLIB_CRC_SLICES >= 4
+/**
+ * CRC16, slicing-by-4 kernel (2 KiB of tables). Same parameters as CRC16_updateBitwise.
+ */
+U16 CRC16_updateSlice4(U16 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!tablesReady) {
+        initTables();
+    }
+    for(; size >= 4; size -= 4, p += 4) {
+        crc = crc16Tables[3][(crc >> 8) ^ p[0]] ^ crc16Tables[2][(crc & 0xFF) ^ p[1]]
+            ^ crc16Tables[1][p[2]] ^ crc16Tables[0][p[3]];
+    }
+    return CRC16_updateTable(crc, p, size);
+}
+#endif
+
+#if OGBWLIB_CRC_SLICES >= 8
+/**
+ * CRC16, slicing-by-8 kernel (4 KiB of tables). Same parameters as CRC16_updateBitwise.
+ */
+U16 CRC16_updateSlice8(U16 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!tablesReady) {
+        initTables();
+    }
+    for(; size >= 8; size -= 8, p += 8) {
+        crc = crc16Tables[7][(crc >> 8) ^ p[0]] ^ crc16Tables[6][(crc & 0xFF) ^ p[1]]
+            ^ crc16Tables[5][p[2]] ^ crc16Tables[4][p[3]] ^ crc16Tables[3][p[4]]
+            ^ crc16Tables[2][p[5]] ^ crc16Tables[1][p[6]] ^ crc16Tables[0][p[7]];
+    }
+    return CRC16_updateTable(crc, p, size);
+}
+#endif
+
+/**
+ * CRC16, with the fastest kernel compiled (see OGBWLIB_CRC_SLICES). Same parameters as CRC16_updateBitwise.
+ */
+U16 CRC16_update(U16 crc, const void* data, USIZE size) {
+#if OGBWLIB_CRC_SLICES >= 8
+    return CRC16_updateSlice8(crc, data, size);
+#elif OGBWLIB_CRC_SLICES >= 4
+    return CRC16_updateSlice4(crc, data, size);
+#elif OGBWLIB_CRC_SLICES >= 1
+    return CRC16_updateTable(crc, data, size);
+#else
+    return CRC16_updateNibble(crc, data, size);
+#endif
+}
+
+/**
+ * CRC16 of the content of a ByteFIFO, from the oldest byte to the newest. The content is not modified.
+ * @param crc   CRC16_INIT, or the value returned for the previous data
+ * @param fifo  ByteFIFO to read
+ * @return      CRC16 of all the data given so far
+ */
+U16 CRC16_updateByteFIFO(U16 crc, const ByteFIFO fifo) {
+    USIZE first = fifo->size - fifo->readPtr;
+    if(first >= fifo->dataSize) {
+        return CRC16_update(crc, fifo->data + fifo->readPtr, fifo->dataSize);
+    }
+    crc = CRC16_update(crc, fifo->data + fifo->readPtr, first);
+    return CRC16_update(crc, fifo->data, fifo->dataSize - first);
+}
+
+/**
+ * CRC32, bitwise kernel (no table).
+ * @param crc   CRC32_INIT, or the value returned for the previous data
+ * @param data  data
+ * @param size  number of bytes
+ * @return      value to give for the next data. Apply CRC32_final to get the CRC32.
+ */
+U32 CRC32_updateBitwise(U32 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    U8 j;
+    while(size--) {
+        crc ^= *p++;
+        for(j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32_POLY : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * CRC32, nibble kernel (64 bytes table). Same parameters as CRC32_updateBitwise.
+ */
+U32 CRC32_updateNibble(U32 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!nibbleReady) {
+        initNibble();
+    }
+    while(size--) {
+        U8 b = *p++;
+        crc = (crc >> 4) ^ crc32Nibble[(crc ^ b) & 0x0F];
+        crc = (crc >> 4) ^ crc32Nibble[(crc ^ (b >> 4)) & 0x0F];
+    }
+    return crc;
+}
+
+#if OGBWLIB_CRC_SLICES >= 1
+/**
+ * CRC32, byte table kernel (1 KiB table). Same parameters as CRC32_updateBitwise.
+ */
+U32 CRC32_updateTable(U32 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!tablesReady) {
+        initTables();
+    }
+    while(size--) {
+        crc = (crc >> 8) ^ crc32Tables[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+#endif
+
+#if OGBWLIB_CRC_SLICES >= 4
+/**
+ * CRC32, slicing-by-4 kernel (4 KiB of tables). Same parameters as CRC32_updateBitwise.
+ */
+U32 CRC32_updateSlice4(U32 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!tablesReady) {
+        initTables();
+    }
+    for(; size >= 4; size -= 4, p += 4) {
+        crc ^= (U32)p[0] | (U32)p[1] << 8 | (U32)p[2] << 16 | (U32)p[3] << 24;    // byte by byte: no alignment nor endianness constraint
+        crc = crc32Tables[3][crc & 0xFF] ^ crc32Tables[2][(crc >> 8) & 0xFF]
+            ^ crc32Tables[1][(crc >> 16) & 0xFF] ^ crc32Tables[0][crc >> 24];
+    }
+    return CRC32_updateTable(crc, p, size);
+}
+#endif
+
+#if OGBWLIB_CRC_SLICES >= 8
+/**
+ * CRC32, slicing-by-8 kernel (8 KiB of tables). Same parameters as CRC32_updateBitwise.
+ */
+U32 CRC32_updateSlice8(U32 crc, const void* data, USIZE size) {
+    const U8* p = (const U8*)data;
+    if(!tablesReady) {
+        initTables();
+    }
+    for(; size >= 8; size -= 8, p += 8) {
+        crc ^= (U32)p[0] | (U32)p[1] << 8 | (U32)p[2] << 16 | (U32)p[3] << 24;
+        crc = crc32Tables[7][crc & 0xFF] ^ crc32Tables[6][(crc >> 8) & 0xFF]
+            ^ crc32Tables[5][(crc >> 16) & 0xFF] ^ crc32Tables[4][crc >> 24]
+            ^ crc32Tables[3][p[4]] ^ crc32Tables[2][p[5]]
+            ^ crc32Tables[1][p[6]] ^ crc32Tables[0][p[7]];
+    }
+    return CRC32_updateTable(crc, p, size);
+}
+#endif
+
+/**
+ * CRC32, with the fastest kernel compiled (see OGBWLIB_CRC_SLICES). Same parameters as CRC32_updateBitwise.
+ */
+U32 CRC32_update(U32 crc, const void* data, USIZE size) {
+#if OGBWLIB_CRC_SLICES >= 8
+    return CRC32_updateSlice8(crc, data, size);
+#elif OGBWLIB_CRC_SLICES >= 4
+    return CRC32_updateSlice4(crc, data, size);
+#elif OGBWLIB_CRC_SLICES >= 1
+    return CRC32_updateTable(crc, data, size);
+#else
+    return CRC32_updateNibble(crc, data, size);
+#endif
+}
+
+/**
+ * CRC32 of the content of a ByteFIFO, from the oldest byte to the newest. The content is not modified.
+ * @param crc   CRC32_INIT, or the value returned for the previous data
+ * @param fifo  ByteFIFO to read
+ * @return      value to give for the next data. Apply CRC32_final to get the CRC32.
+ */
+U32 CRC32_updateByteFIFO(U32 crc, const ByteFIFO fifo) {
+    USIZE first = fifo->size - fifo->readPtr;
+    if(first >= fifo->dataSize) {
+        return CRC32_update(crc, fifo->data + fifo->readPtr, fifo->dataSize);
+    }
+    crc = CRC32_update(crc, fifo->data + fifo->readPtr, first);
+    return CRC32_update(crc, fifo->data, fifo->dataSize - first);
+}
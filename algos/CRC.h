@@ -0,0 +1,61 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include "../typedef.h"
+#include "lists/ByteFIFO.h"
+
+/*
+ * Number of tables of the fastest kernel compiled: 0 (nibble kernel only, 96 bytes of tables), 1 (byte table), 4 or 8 (slicing-by-4 or by-8).
+ * The tables are in RAM: the CRC16 ones take 512 bytes per table, the CRC32 ones 1 KiB. On the dsPIC, the default is the nibble kernel.
+ */
+#ifndef OGBWLIB_CRC_SLICES
+#if defined(__XC16__) || defined(__C30__)
+#define OGBWLIB_CRC_SLICES  0
+#else
+#define OGBWLIB_CRC_SLICES  8
+#endif
+#endif
+
+/// CRC16 polynomial, MSB first (default: CCITT)
+#ifndef CRC16_POLY
+#define CRC16_POLY          0x1021
+#endif
+/// CRC32 polynomial, reflected (LSB first, default: IEEE 802.3, as in Ethernet, zip, png...)
+#ifndef CRC32_POLY
+#define CRC32_POLY          0xEDB88320UL
+#endif
+
+#define CRC16_INIT          0xFFFF
+#define CRC32_INIT          0xFFFFFFFFUL
+/// CRC32 of the data, from the value returned by the last update
+#define CRC32_final(crc)    ((crc) ^ 0xFFFFFFFFUL)
+
+U16 CRC16_updateBitwise(U16 crc, const void* data, USIZE size);
+U16 CRC16_updateNibble(U16 crc, const void* data, USIZE size);
+#if OGBWLIB_CRC_SLICES >= 1
+U16 CRC16_updateTable(U16 crc, const void* data, USIZE size);
+#endif
+#if OGBWLIB_CRC_SLICES >= 4
+U16 CRC16_updateSlice4(U16 crc, const void* data, USIZE size);
+#endif
+#if OGBWLIB_CRC_SLICES >= 8
+U16 CRC16_updateSlice8(U16 crc, const void* data, USIZE size);
+#endif
+U16 CRC16_update(U16 crc, const void* data, USIZE size);
+U16 CRC16_updateByteFIFO(U16 crc, const ByteFIFO fifo);
+
+U32 CRC32_updateBitwise(U32 crc, const void* data, USIZE size);
+U32 CRC32_updateNibble(U32 crc, const void* data, USIZE size);
+#if OGBWLIB_CRC_SLICES >= 1
+U32 CRC32_updateTable(U32 crc, const void* data, USIZE size);
+#endif
+#if OGBWLIB_CRC_SLICES >= 4
+U32 CRC32_updateSlice4(U32 crc, const void* data, USIZE size);
+#endif
+#if OGBWLIB_CRC_SLICES >= 8
+U32 CRC32_updateSlice8(U32 crc, const void* data, USIZE size);
+#endif
+U32 CRC32_update(U32 crc, const void* data, USIZE size);
+U32 CRC32_updateByteFIFO(U32 crc, const ByteFIFO fifo);
+
+#endif //CRC_H
@@ -0,0 +1,388 @@
+/** @file       Format.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Format writes integers and floats as text, directly in a ByteFIFO (e.g. the transmit buffer of a UART): a small replacement of sprintf for the usual debug outputs.
+ *  The text is written in the free space of the container (ByteFIFO_getWriteSpan), and published at once when it is complete: there is no intermediate buffer, and no size limit but the free space.
+ *  If the text does not fit, nothing is written: as the other push functions, a message is written entirely, or not at all.
+ *
+ *  Floats are written with a fixed number of decimals (%f only, no exponent), from the bits of the float: the digits are exact, and rounded to nearest (ties to even) as printf does.
+ *  The computation uses no division and no floating point operation (the integer digits are extracted by subtractions, the decimals by multiplications by 10).
+ *  It is done in float precision: a double argument of Format_print is converted to float first (on the dsPIC, double is float anyway, unless -fno-short-double).
+ *  Values whose integer part does not fit in 32 bits (|value| >= 4294967296) are written "ovf".
+ *
+ *  The implementation offers no garanties against interrupt. If you need to use it on different IPL, protect every call (see UART_sendFormat).
+*/
+
+#include <stdarg.h>
+#include <string.h>
+#include "../typedef.h"
+#include "lists/ByteFIFO.h"
+#include "Format.h"
+
+static const U32 powers10[Format_MAX_DECIMALS + 1] = {1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL};
+
+/// Text being written in the free space of a ByteFIFO
+typedef struct {
+    ByteFIFO fifo;
+    S8* ptr;        /// next byte of the current span
+    USIZE left;     /// bytes left in the current span
+    USIZE written;  /// bytes written since the beginning of the text
+    U8 full;        /// not 0 if the text did not fit
+} Writer;
+
+/// Conversion options: %[-][0][width]
+typedef struct {
+    U8 left;        /// '-': pad on the right
+    U8 zero;        /// '0': pad with zeros, after the sign
+    U8 width;       /// minimal number of characters
+} Field;
+
+static void begin(Writer* w, ByteFIFO fifo) {
+    w->fifo = fifo;
+    w->left = 0;
+    w->written = 0;
+    w->full = 0;
+}
+
+static void put(Writer* w, const char c) {
+    if(w->left == 0) {
+        void* span;
+        if(w->full) {
+            return;
+        }
+        w->left = ByteFIFO_getWriteSpan(w->fifo, w->written, &span);
+        if(w->left == 0) {
+            w->full = 1;
+            return;
+        }
+        w->ptr = (S8*)span;
+    }
+    *w->ptr++ = c;
+    w->left--;
+    w->written++;
+}
+
+static ByteFIFO_Error end(Writer* w) {
+    if(w->full) {
+        return ByteFIFO_FULL;
+    }
+    return ByteFIFO_publish(w->fifo, w->written);
+}
+
+static void putRepeat(Writer* w, const char c, U8 nb) {
+    while(nb-- != 0) {
+        put(w, c);
+    }
+}
+
+static U8 countDigits(const U32 value) {
+    U8 nb = 1;
+    while(nb < 10 && value >= powers10[nb]) {
+        nb++;
+    }
+    return nb;
+}
+
+/**
+ * Write the nb last decimal digits of value (with leading zeros), most significant first.
+ */
+static void putDigits(Writer* w, U32 value, U8 nb) {
+    while(nb > 1) {
+        const U32 p = powers10[--nb];
+        char c = '0';
+        while(value >= p) {
+            value -= p;
+            c++;
+        }
+        put(w, c);
+    }
+    put(w, '0' + (char)value);
+}
+
+/**
+ * Write a field made of a word (nan, inf...), with its sign. It is padded with spaces, even with the '0' flag.
+ */
+static void putWord(Writer* w, const Field* field, const char sign, const char* word) {
+    USIZE size = (sign != 0) + strlen(word);
+    USIZE pad = field->width > size ? field->width - size : 0;
+    if(!field->left) {
+        putRepeat(w, ' ', pad);
+    }
+    if(sign != 0) {
+        put(w, sign);
+    }
+    while(*word != 0) {
+        put(w, *word++);
+    }
+    if(field->left) {
+        putRepeat(w, ' ', pad);
+    }
+}
+
+/**
+ * Write a number: its sign (if not 0), its integer part, and its decimals (frac, on decimals digits), padded to the width of the field.
+ */
+static void putNumber(Writer* w, const Field* field, const char sign, const U32 integer, const U32 frac, const U8 decimals) {
+    U8 digits = countDigits(integer);
+    U8 size = (sign != 0) + digits + (decimals != 0 ? decimals + 1 : 0);
+    U8 pad = field->width > size ? field->width - size : 0;
+    if(!field->left && !field->zero) {
+        putRepeat(w, ' ', pad);
+    }
+    if(sign != 0) {
+        put(w, sign);
+    }
+    if(!field->left && field->zero) {
+        putRepeat(w, '0', pad);
+    }
+    putDigits(w, integer, digits);
+    if(decimals != 0) {
+        put(w, '.');
+        putDigits(w, frac, decimals);
+    }
+    if(field->left) {
+        putRepeat(w, ' ', pad);
+    }
+}
+
+static void putHex(Writer* w, const Field* field, const U32 value, const char* digits) {
+    U8 nb = 1;
+    U8 pad;
+    while(nb < 8 && (value >> (4 * nb)) != 0) {
+        nb++;
+    }
+    pad = field->width > nb ? field->width - nb : 0;
+    if(!field->left) {
+        putRepeat(w, field->zero ? '0' : ' ', pad);
+    }
+    while(nb-- != 0) {
+        put(w, digits[(value >> (4 * nb)) & 0xF]);
+    }
+    if(field->left) {
+        putRepeat(w, ' ', pad);
+    }
+}
+
+/**
+ * Write a float with a fixed number of decimals.
+ * The float is m / 2^shift, with m its 24 bits mantissa: the integer part is m >> shift, and each decimal is the integer part of the remaining fraction multiplied by 10.
+ * The rounding looks at what remains after the last decimal, compared to a half.
+ */
+static void putFloat(Writer* w, const Field* field, const float value, U8 decimals) {
+    union {
+        float f;
+        U32 u;
+    } bits;
+    U32 m;
+    U32 integer = 0;
+    U32 frac = 0;
+    S16 shift;
+    U8 up;
+    char sign;
+
+    bits.f = value;
+    sign = (bits.u >> 31) != 0 ? '-' : 0;
+    m = bits.u & 0x007FFFFFUL;
+    shift = (bits.u >> 23) & 0xFF;
+    if(shift == 0xFF) {
+        putWord(w, field, sign, m != 0 ? "nan" : "inf");
+        return;
+    }
+    if(shift == 0) {    // denormal
+        shift = 1;
+    } else {
+        m |= 0x00800000UL;
+    }
+    shift = 150 - shift;
+    if(decimals > Format_MAX_DECIMALS) {
+        decimals = Format_MAX_DECIMALS;
+    }
+
+    if(shift <= 0) {            // integer
+        if(shift < -8) {
+            putWord(w, field, sign, "ovf");
+            return;
+        }
+        putNumber(w, field, sign, m << -shift, 0, decimals);
+        return;
+    }
+    if(shift <= 28) {           // |value| >= 1/16: the fraction times 10 fits in 32 bits
+        const U32 mask = (1UL << shift) - 1;
+        const U32 half = 1UL << (shift - 1);
+        U32 rest = m & mask;
+        U8 i;
+        integer = m >> shift;
+        for(i = 0; i < decimals; i++) {
+            rest *= 10;
+            frac = frac * 10 + (rest >> shift);
+            rest &= mask;
+        }
+        up = rest > half || (rest == half && ((decimals != 0 ? frac : integer) & 1));
+    } else if(shift < 64) {     // |value| < 1/16: rare, the 64 bits product is exact
+        const unsigned long long product = (unsigned long long)m * powers10[decimals];
+        const unsigned long long half = 1ULL << (shift - 1);
+        const unsigned long long rest = product & ((half << 1) - 1);
+        frac = (U32)(product >> shift);
+        up = rest > half || (rest == half && (frac & 1));
+    } else {                    // far below the last decimal
+        up = 0;
+    }
+    if(up) {
+        if(decimals == 0) {
+            integer++;
+        } else if(++frac == powers10[decimals]) {
+            frac = 0;
+            integer++;
+        }
+    }
+    putNumber(w, field, sign, integer, frac, decimals);
+}
+
+static void putInt(Writer* w, const Field* field, const S32 value) {
+    if(value < 0) {
+        putNumber(w, field, '-', 0UL - (U32)value, 0, 0);
+    } else {
+        putNumber(w, field, 0, (U32)value, 0, 0);
+    }
+}
+
+/**
+ * Write formatted text (see Format_print).
+ */
+static void putText(Writer* w, const char* format, va_list args) {
+    while(*format != 0) {
+        Field field = {0, 0, 0};
+        U8 precision = 6;
+        U8 isLong = 0;
+        char c = *format++;
+        if(c != '%') {
+            put(w, c);
+            continue;
+        }
+        for(;; format++) {
+            if(*format == '-') {
+                field.left = 1;
+            } else if(*format == '0') {
+                field.zero = 1;
+            } else {
+                break;
+            }
+        }
+        while(*format >= '0' && *format <= '9') {
+            field.width = field.width * 10 + *format++ - '0';
+        }
+        if(*format == '.') {
+            format++;
+            precision = 0;
+            while(*format >= '0' && *format <= '9') {
+                if(precision <= Format_MAX_DECIMALS) {
+                    precision = precision * 10 + *format - '0';
+                }
+                format++;
+            }
+        }
+        while(*format == 'l' || *format == 'h') {
+            isLong |= *format++ == 'l';
+        }
+        c = *format;
+        if(c == 0) {
+            break;
+        }
+        format++;
+        switch(c) {
+            case 'd':
+            case 'i':
+                putInt(w, &field, isLong ? (S32)va_arg(args, long) : (S32)va_arg(args, int));
+                break;
+            case 'u':
+                putNumber(w, &field, 0, isLong ? (U32)va_arg(args, unsigned long) : (U32)va_arg(args, unsigned int), 0, 0);
+                break;
+            case 'x':
+                putHex(w, &field, isLong ? (U32)va_arg(args, unsigned long) : (U32)va_arg(args, unsigned int), "0123456789abcdef");
+                break;
+            case 'X':
+                putHex(w, &field, isLong ? (U32)va_arg(args, unsigned long) : (U32)va_arg(args, unsigned int), "0123456789ABCDEF");
+                break;
+            case 'c':
+                put(w, (char)va_arg(args, int));
+                break;
+            case 's':
+                putWord(w, &field, 0, va_arg(args, const char*));
+                break;
+            case 'f':
+                putFloat(w, &field, (float)va_arg(args, double), precision);
+                break;
+            case '%':
+                put(w, '%');
+                break;
+            default:
+                put(w, '%');
+                put(w, c);
+                break;
+        }
+    }
+}
+
+/**
+ * Write an integer in decimal.
+ * @return  ByteFIFO_FULL if the container did not have enought free space. In this case, nothing is written. ByteFIFO_OK otherwise.
+ */
+ByteFIFO_Error Format_pushInt(ByteFIFO fifo, const S32 value) {
+    const Field field = {0, 0, 0};
+    Writer w;
+    begin(&w, fifo);
+    putInt(&w, &field, value);
+    return end(&w);
+}
+
+/**
+ * Write an unsigned integer in decimal.
+ * @return  ByteFIFO_FULL if the container did not have enought free space. In this case, nothing is written. ByteFIFO_OK otherwise.
+ */
+ByteFIFO_Error Format_pushUInt(ByteFIFO fifo, const U32 value) {
+    const Field field = {0, 0, 0};
+    Writer w;
+    begin(&w, fifo);
+    putNumber(&w, &field, 0, value, 0, 0);
+    return end(&w);
+}
+
+/**
+ * Write a float with a fixed number of decimals, as printf("%.<decimals>f").
+ * @param decimals  number of decimals, Format_MAX_DECIMALS at most. With 0, there is no decimal point.
+ * @return          ByteFIFO_FULL if the container did not have enought free space. In this case, nothing is written. ByteFIFO_OK otherwise.
+ */
+ByteFIFO_Error Format_pushFloat(ByteFIFO fifo, const float value, const U8 decimals) {
+    const Field field = {0, 0, 0};
+    Writer w;
+    begin(&w, fifo);
+    putFloat(&w, &field, value, decimals);
+    return end(&w);
+}
+
+/**
+ * Write formatted text, as printf, for a subset of its conversions:
+ *      %d %i %u %x %X %c %s %f %%, with the flags '-' and '0', a width, and a precision (number of decimals of %f, 6 by default, Format_MAX_DECIMALS at most).
+ *      'l' reads a long argument (32 bits) for %d %i %u %x %X, 'h' is ignored. Other conversions are written as they are, without reading an argument.
+ * @return  ByteFIFO_FULL if the container did not have enought free space for the whole text. In this case, nothing is written. ByteFIFO_OK otherwise.
+ */
+ByteFIFO_Error Format_print(ByteFIFO fifo, const char* format, ...) {
+    ByteFIFO_Error ret;
+    va_list args;
+    va_start(args, format);
+    ret = Format_vprint(fifo, format, args);
+    va_end(args);
+    return ret;
+}
+
+/**
+ * Same as Format_print, with a va_list.
+ */
+ByteFIFO_Error Format_vprint(ByteFIFO fifo, const char* format, va_list args) {
+    Writer w;
+    begin(&w, fifo);
+    putText(&w, format, args);
+    return end(&w);
+}
@@ -0,0 +1,17 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stdarg.h>
+#include "../typedef.h"
+#include "lists/ByteFIFO.h"
+
+/// maximal number of decimals of Format_pushFloat and %f (more are ignored)
+#define Format_MAX_DECIMALS     9
+
+ByteFIFO_Error Format_pushInt(ByteFIFO fifo, const S32 value);
+ByteFIFO_Error Format_pushUInt(ByteFIFO fifo, const U32 value);
+ByteFIFO_Error Format_pushFloat(ByteFIFO fifo, const float value, const U8 decimals);
+ByteFIFO_Error Format_print(ByteFIFO fifo, const char* format, ...);
+ByteFIFO_Error Format_vprint(ByteFIFO fifo, const char* format, va_list args);
+
+#endif //FORMAT_H
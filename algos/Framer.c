@@ -0,0 +1,307 @@
+/** @file       Framer.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Framer cuts a byte stream (typically a UART) into frames, and checks them.
+ *  On the line, a frame is its payload followed by a CRC16 (CCITT, big endian), encoded with COBS (Consistent Overhead Byte Stuffing), and ended by a 0x00 delimiter.
+ *  COBS removes every 0x00 from the encoded data, for a constant overhead of 1 byte per 254 bytes: the delimiter can't appear inside a frame,
+ *  so a receiver that lost some bytes (noise, overrun, late start) resynchronizes at the next delimiter, and the CRC rejects the damaged frame.
+ *
+ *  Encoding (Framer_encode) writes directly in a ByteFIFO (e.g. the transmit buffer of a UART), from the parts of the message given by the caller: no intermediate buffer.
+ *  Decoding (Framer_decode, Framer_decodeBytes) is incremental: bytes are processed as they come, and each valid frame is written in an ObjectFIFO, as a Framer_Frame.
+ *  The frame is decoded in place, in memory claimed in the ObjectFIFO (ObjectFIFO_claim), and published when its CRC is checked: there is no copy after the decoding.
+ *  The CRC (CRC.c) is computed once the frame is complete, on the payload and the CRC, in one call: a valid frame gives a CRC of 0.
+ *
+ *  Frames can be empty (the CRC is always there), consecutive delimiters are ignored. A frame bigger than maxSize is dropped.
+ *  The implementation offers no garanties against interrupt: a Framer must be used by a single writer and a single reader.
+ *  The output ObjectFIFO can be read by an other part of the code with ObjectFIFO_borrow/ObjectFIFO_release, without protection.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "../typedef.h"
+#include "Framer.h"
+#include "CRC.h"
+
+// values of discard
+#define KEEP            0   // decoding
+#define DROP_ERROR      1   // the frame is wrong, count it at the delimiter
+#define DROP_SILENT     2   // the frame is already counted, or it may be the end of a frame received partially
+
+/**
+ * Create a new framer.
+ * @param maxSize   maximal size of the payload of a frame. Frames are claimed in output with this size (plus the CRC), then shrunk to their actual size.
+ * @param output    where the decoded frames are written. It must be able to hold at least two frames of maxSize + Framer_CRC_SIZE bytes: even empty, an ObjectFIFO may not give a block bigger than half of its size (see ObjectFIFO_new).
+ * @return          the framer, null if there is not enought memory
+ * @warning         This is a malloc, free it with Framer_free.
+ */
+Framer Framer_new(const USIZE maxSize, ObjectFIFO output) {
+    Framer framer = (Framer)malloc(sizeof(struct Framer_struct));
+    if(framer == null) {
+        return null;
+    }
+    framer->output = output;
+    framer->maxSize = maxSize;
+    framer->frame = null;
+    Framer_reset(framer);
+    framer->discard = KEEP;     // the stream is expected to start with a frame, if not, its CRC will be wrong
+    Framer_resetStats(framer);
+    return framer;
+}
+
+/**
+ * Free the memory used by a framer. The output ObjectFIFO is not freed.
+ */
+void Framer_free(Framer framer) {
+    free(framer);
+}
+
+/**
+ * Drop the frame being decoded: the next frame starts after the next delimiter.
+ */
+void Framer_reset(Framer framer) {
+    framer->length = 0;
+    framer->code = 0;
+    framer->remaining = 0;
+    framer->discard = DROP_SILENT;
+}
+
+/// Source of the bytes to encode: the segments of the caller, then the CRC
+typedef struct {
+    const ByteFIFO_Segment* segments;
+    U16 nb;             /// segments left after the current one
+    const U8* data;     /// next byte of the current segment
+    USIZE size;         /// bytes left in the current segment
+    const U8* tail;     /// last segment, used when the caller ones are finished (null once it is used)
+    USIZE tailSize;
+} Cursor;
+
+/**
+ * Make data point to a non-empty segment.
+ * @return  false if there is no more data
+ */
+static U8 cursorNext(Cursor* cursor) {
+    while(cursor->size == 0) {
+        if(cursor->nb != 0) {
+            cursor->data = cursor->segments->data;
+            cursor->size = cursor->segments->size;
+            cursor->segments++;
+            cursor->nb--;
+        } else if(cursor->tail != null) {
+            cursor->data = cursor->tail;
+            cursor->size = cursor->tailSize;
+            cursor->tail = null;
+        } else {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Compute the CRC of a payload, as written by Framer_encode.
+ * @param segments  parts of the payload, in order
+ * @param nb        number of segments
+ * @return          the CRC to give to Framer_encodeWithCrc
+ */
+U16 Framer_crc(const ByteFIFO_Segment* segments, const U16 nb) {
+    U16 crc = CRC16_INIT;
+    U16 i;
+    for(i = 0; i < nb; i++) {
+        crc = CRC16_update(crc, segments[i].data, segments[i].size);
+    }
+    return crc;
+}
+
+/**
+ * Encode a frame, and write it in a ByteFIFO. The frame is made of the segments, one after the other (e.g. header and payload).
+ * All the bytes are written directly in output: the data is only read once to compute the CRC, and once to encode it.
+ * @param output    where the frame is written
+ * @param segments  parts of the payload, in order
+ * @param nb        number of segments
+ * @return          ByteFIFO_FULL if output may not have enought free space for the encoded frame (see Framer_encodedSize). In this case, nothing is written.
+ * @return          ByteFIFO_OK if the frame was written.
+ * @remark          The payload can be bigger than the maxSize of the framer, which only limits what it decodes.
+ */
+ByteFIFO_Error Framer_encode(Framer framer, ByteFIFO output, const ByteFIFO_Segment* segments, const U16 nb) {
+    return Framer_encodeWithCrc(framer, output, segments, nb, Framer_crc(segments, nb));
+}
+
+/**
+ * Same as Framer_encode, with the CRC of the payload already computed by Framer_crc.
+ * The CRC can so be computed out of a critical section, and only the encoding done in it (see UART_sendFrame).
+ * @param crc       Framer_crc(segments, nb). The segments must not change between the two calls.
+ */
+ByteFIFO_Error Framer_encodeWithCrc(Framer framer, ByteFIFO output, const ByteFIFO_Segment* segments, const U16 nb, const U16 crc) {
+    Cursor cursor;
+    USIZE size = 0;
+    U8 crcBytes[Framer_CRC_SIZE];
+    U16 i;
+
+    for(i = 0; i < nb; i++) {
+        size += segments[i].size;
+    }
+    if(ByteFIFO_getAvailableSize(output) < Framer_encodedSize(size)) {
+        return ByteFIFO_FULL;
+    }
+    crcBytes[0] = crc >> 8;
+    crcBytes[1] = crc;
+
+    cursor.segments = segments;
+    cursor.nb = nb;
+    cursor.size = 0;
+    cursor.tail = crcBytes;
+    cursor.tailSize = Framer_CRC_SIZE;
+
+    // Each block is a code byte n, followed by the n-1 next bytes of data, none of them being 0. If n < 0xFF, a 0 follows in the data (except for the last block).
+    for(;;) {
+        USIZE run = 0;          // number of bytes of the block
+        U8 zero = 0;            // the block ends on a 0 of the data
+        Cursor start;
+        cursorNext(&cursor);
+        start = cursor;
+        while(run < 254 && cursorNext(&cursor)) {
+            const U8* end = cursor.data + (cursor.size < 254 - run ? cursor.size : 254 - run);
+            const U8* p = cursor.data;
+            while(p < end && *p != 0) {
+                p++;
+            }
+            run += p - cursor.data;
+            cursor.size -= p - cursor.data;
+            cursor.data = p;
+            if(p < end) {
+                zero = 1;
+                break;
+            }
+        }
+        ByteFIFO_pushByte(output, run + 1);
+        while(run != 0) {       // copy the block, from where it started
+            USIZE n;
+            cursorNext(&start);
+            n = start.size < run ? start.size : run;
+            ByteFIFO_pushBlock(output, n, start.data);
+            start.data += n;
+            start.size -= n;
+            run -= n;
+        }
+        if(zero) {              // skip the 0, a new block follows (even if the 0 was the last byte)
+            cursor.data++;
+            cursor.size--;
+        } else if(!cursorNext(&cursor)) {
+            break;
+        }
+    }
+    ByteFIFO_pushByte(output, Framer_DELIMITER);
+    framer->stats.framesEncoded++;
+    return ByteFIFO_OK;
+}
+
+/**
+ * End of the frame being decoded: publish it if it is valid.
+ */
+static void endFrame(Framer framer) {
+    if(framer->discard == DROP_ERROR) {
+        framer->stats.formatErrors++;
+    } else if(framer->discard == DROP_SILENT) {
+        // nothing to count
+    } else if(framer->code == 0) {
+        // consecutive delimiters
+    } else if(framer->remaining != 0 || framer->length < Framer_CRC_SIZE) {
+        framer->stats.formatErrors++;
+    } else if(CRC16_update(CRC16_INIT, framer->frame->data, framer->length) != 0) {
+        framer->stats.crcErrors++;
+    } else {
+        framer->frame->size = framer->length - Framer_CRC_SIZE;
+        ObjectFIFO_publishSize(framer->output, sizeof(Framer_Frame) + framer->frame->size);
+        framer->frame = null;
+        framer->stats.framesDecoded++;
+    }
+    framer->length = 0;
+    framer->code = 0;
+    framer->remaining = 0;
+    framer->discard = KEEP;
+}
+
+/**
+ * Decode a part of the byte stream. The valid frames ended in it are written in the output ObjectFIFO.
+ * @param data  bytes received
+ * @param size  number of bytes
+ * @return      number of frames written in the output ObjectFIFO
+ * @remark      This is what a zero-copy consumer of a DMA receive buffer can call (see UART_initRxDMA).
+ */
+USIZE Framer_decodeBytes(Framer framer, const void* data, const USIZE size) {
+    const U8* p = (const U8*)data;
+    const U8* end = p + size;
+    U32 decoded = framer->stats.framesDecoded;
+
+    while(p < end) {
+        U8 b = *p++;
+        if(b == Framer_DELIMITER) {
+            endFrame(framer);
+            continue;
+        }
+        if(framer->discard) {
+            continue;
+        }
+        if(framer->code == 0 && framer->frame == null) {    // first byte of a frame: claim the memory to decode it
+            framer->frame = (Framer_Frame*)ObjectFIFO_claim(framer->output, sizeof(Framer_Frame) + framer->maxSize + Framer_CRC_SIZE);
+            if(framer->frame == null) {
+                framer->stats.overflows++;
+                framer->discard = DROP_SILENT;
+                continue;
+            }
+        }
+        if(framer->remaining == 0) {    // code byte
+            if(framer->code != 0 && framer->code != 0xFF) {   // the previous block ended on a 0
+                if(framer->length == framer->maxSize + Framer_CRC_SIZE) {
+                    framer->discard = DROP_ERROR;
+                    continue;
+                }
+                framer->frame->data[framer->length++] = 0;
+            }
+            framer->code = b;
+            framer->remaining = b - 1;
+        } else {
+            if(framer->length == framer->maxSize + Framer_CRC_SIZE) {
+                framer->discard = DROP_ERROR;
+                continue;
+            }
+            framer->frame->data[framer->length++] = b;
+            framer->remaining--;
+        }
+    }
+    return framer->stats.framesDecoded - decoded;
+}
+
+/**
+ * Decode all the bytes of a ByteFIFO (e.g. the receive buffer of a UART), and remove them. The valid frames are written in the output ObjectFIFO.
+ * The bytes are decoded where they are, contiguous part after contiguous part (ByteFIFO_getReadSpan).
+ * @param input ByteFIFO to read
+ * @return      number of frames written in the output ObjectFIFO
+ */
+USIZE Framer_decode(Framer framer, ByteFIFO input) {
+    USIZE ret = 0;
+    const void* data;
+    USIZE size;
+    while((size = ByteFIFO_getReadSpan(input, &data)) != 0) {
+        ret += Framer_decodeBytes(framer, data, size);
+        ByteFIFO_skip(input, size);
+    }
+    return ret;
+}
+
+/**
+ * Get the statistics of a framer.
+ * @param stats     where the statistics are copied
+ */
+void Framer_getStats(const Framer framer, Framer_Stats* stats) {
+    *stats = framer->stats;
+}
+
+/**
+ * Reset the statistics of a framer to 0.
+ */
+void Framer_resetStats(Framer framer) {
+    memset(&framer->stats, 0, sizeof(framer->stats));
+}
@@ -0,0 +1,55 @@
+#ifndef FRAMER_H
+#define FRAMER_H
+
+#include "../typedef.h"
+#include "lists/ByteFIFO.h"
+#include "lists/ObjectFIFO.h"
+
+/**
+ * Frame decoded by a Framer, as written in its output ObjectFIFO.
+ */
+typedef struct {
+    USIZE size;     /// size of the payload
+    U8 data[];      /// payload
+} Framer_Frame;
+
+/**
+ * Statistics of a Framer, since its creation or the last Framer_resetStats.
+ */
+typedef struct {
+    U32 framesEncoded;  /// frames written by Framer_encode
+    U32 framesDecoded;  /// valid frames written in the output ObjectFIFO
+    U32 crcErrors;      /// frames dropped because of a wrong CRC
+    U32 formatErrors;   /// frames dropped because they were truncated, too short to hold a CRC, or bigger than maxSize
+    U32 overflows;      /// valid frames dropped because the output ObjectFIFO was full
+} Framer_Stats;
+
+struct Framer_struct {
+    ObjectFIFO output;  /// where the decoded frames are written
+    USIZE maxSize;      /// maximal size of a payload
+    Framer_Frame* frame;/// frame being decoded, claimed in output (null if none)
+    USIZE length;       /// number of bytes decoded in frame (payload and CRC)
+    U8 code;            /// COBS code of the current block, 0 at the beginning of a frame
+    U8 remaining;       /// bytes of the current block still to decode
+    U8 discard;         /// not 0 if the bytes are ignored until the next delimiter
+    Framer_Stats stats;
+};
+typedef struct Framer_struct* Framer;
+
+#define Framer_DELIMITER                0x00
+#define Framer_CRC_SIZE                 2
+/// maximal number of bytes written by Framer_encode for a payload of size bytes
+#define Framer_encodedSize(size)        ((size) + Framer_CRC_SIZE + ((size) + Framer_CRC_SIZE) / 254 + 2)
+
+Framer Framer_new(const USIZE maxSize, ObjectFIFO output);
+void Framer_free(Framer framer);
+void Framer_reset(Framer framer);
+U16 Framer_crc(const ByteFIFO_Segment* segments, const U16 nb);
+ByteFIFO_Error Framer_encode(Framer framer, ByteFIFO output, const ByteFIFO_Segment* segments, const U16 nb);
+ByteFIFO_Error Framer_encodeWithCrc(Framer framer, ByteFIFO output, const ByteFIFO_Segment* segments, const U16 nb, const U16 crc);
+USIZE Framer_decodeBytes(Framer framer, const void* data, const USIZE size);
+USIZE Framer_decode(Framer framer, ByteFIFO input);
+void Framer_getStats(const Framer framer, Framer_Stats* stats);
+void Framer_resetStats(Framer framer);
+
+#endif //FRAMER_H
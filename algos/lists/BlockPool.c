@@ -0,0 +1,128 @@
+/** @file       BlockPool.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  BlockPool is an allocator for blocks of a single, fixed size. It is meant to replace malloc/free when a lot of small objects of the same type are created and destroyed (list items, messages...).
+ *  All the memory is allocated once, when the pool is created. Allocating and releasing a block are then done in constant (and very short) time, without any fragmentation: free blocks are chained in a list, using their own memory to store the link.
+ *  The pool keeps some statistics (lowest number of free blocks reached, number of refused allocations), so that you can size it correctly.
+ *  The implementation offers no garanties against interrupt. If you need to use it on different IPL, protect every call to this library.
+*/
+
+#include <stdlib.h>
+#include "typedef.h"
+#include "BlockPool.h"
+
+/**
+ * Creates a new pool.
+ * @param blockSize size of a block (in bytes). It is rounded up to a multiple of the size of a pointer.
+ * @param blockNb   number of blocks of the pool
+ * @return          the pool created, null if there was not enought memory
+ * @warning         Memory is allocated with a malloc. You have to set the linker so it allocates at least blockNb * blockSize + 12 bytes on the heap. You can free the memory with the BlockPool_free function.
+ */
+BlockPool BlockPool_new(const USIZE blockSize, const USIZE blockNb) {
+    const USIZE size = (blockSize + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+    BlockPool ret = malloc(sizeof(struct BlockPool_struct) + (U32)size * blockNb);
+    if (ret != null) {
+        ret->blockSize = size;
+        ret->blockNb = blockNb;
+        BlockPool_clear(ret);
+    }
+    return ret;
+}
+
+/**
+ * Get the size of the blocks
+ * @return      size of a block (in bytes), after rounding
+ */
+inline USIZE BlockPool_getBlockSize(const BlockPool pool) {
+    return pool->blockSize;
+}
+
+/**
+ * Get the number of free blocks
+ * @return      number of blocks that can still be allocated
+ */
+inline USIZE BlockPool_getFreeNb(const BlockPool pool) {
+    return pool->freeNb;
+}
+
+/**
+ * Get the lowest number of free blocks reached since the creation of the pool (or the last call to BlockPool_resetStats).
+ * @return      low-water mark of the number of free blocks. 0 means the pool has been exhausted at least once.
+ */
+inline USIZE BlockPool_getMinFreeNb(const BlockPool pool) {
+    return pool->minFreeNb;
+}
+
+/**
+ * Get the number of allocations that failed because the pool was empty, since the creation of the pool (or the last call to BlockPool_resetStats).
+ * @return      number of failed allocations
+ */
+inline USIZE BlockPool_getFailNb(const BlockPool pool) {
+    return pool->failNb;
+}
+
+/**
+ * Reset the statistics of the pool.
+ */
+inline void BlockPool_resetStats(BlockPool pool) {
+    pool->minFreeNb = pool->freeNb;
+    pool->failNb = 0;
+}
+
+/**
+ * Release all the blocks at once.
+ * @warning     Every block previously allocated must be considered as freed. This function is in O(blockNb).
+ */
+void BlockPool_clear(BlockPool pool) {
+    U8* block = (U8*) pool->data;
+    USIZE i;
+    pool->freeList = null;
+    for(i = pool->blockNb; i > 0; i--) {    // chained from the last to the first, so that the first blocks are allocated first
+        void** b = (void**)(block + (U32)(i-1) * pool->blockSize);
+        *b = pool->freeList;
+        pool->freeList = b;
+    }
+    pool->freeNb = pool->blockNb;
+    BlockPool_resetStats(pool);
+}
+
+/**
+ * Unallocate the memory used by this pool.
+ * @warning     Don't call this function on a non-initialized pool. Every block allocated from this pool becomes invalid.
+ */
+inline void BlockPool_free(BlockPool pool) {
+    free(pool);
+}
+
+/**
+ * Allocate a block.
+ * @return      ptr to the allocated block, null if the pool was empty. The content of the block is undefined.
+ */
+inline void* BlockPool_alloc(BlockPool pool) {
+    void** block = (void**) pool->freeList;
+    if(block == null) {
+        pool->failNb++;
+        return null;
+    }
+    pool->freeList = *block;
+    pool->freeNb--;
+    if(pool->freeNb < pool->minFreeNb) {
+        pool->minFreeNb = pool->freeNb;
+    }
+    return block;
+}
+
+/**
+ * Give a block back to the pool.
+ * @param block ptr to the block, as returned by BlockPool_alloc. null is ignored.
+ * @warning     Just like free, don't release a block twice, or a block that was not allocated from this pool.
+ */
+inline void BlockPool_release(BlockPool pool, void* block) {
+    if(block != null) {
+        *(void**)block = pool->freeList;
+        pool->freeList = block;
+        pool->freeNb++;
+    }
+}
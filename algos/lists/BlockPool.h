@@ -0,0 +1,31 @@
+#ifndef BLOCKPOOL_H
+#define BLOCKPOOL_H
+
+#include "../../typedef.h"
+
+struct BlockPool_struct {
+    USIZE blockSize;    /// size of a block (rounded up so that a free block can hold a pointer)
+    USIZE blockNb;      /// total number of blocks
+    USIZE freeNb;       /// number of blocks actually free
+    USIZE minFreeNb;    /// lowest value reached by freeNb (low-water mark)
+    USIZE failNb;       /// number of allocations refused because the pool was empty
+    void* freeList;     /// first free block. Each free block starts with a pointer to the next one.
+    void* data[];       /// blocks container
+};
+typedef struct BlockPool_struct* BlockPool;
+
+BlockPool BlockPool_new(const USIZE blockSize, const USIZE blockNb);
+
+inline USIZE BlockPool_getBlockSize(const BlockPool pool);
+inline USIZE BlockPool_getFreeNb(const BlockPool pool);
+inline USIZE BlockPool_getMinFreeNb(const BlockPool pool);
+inline USIZE BlockPool_getFailNb(const BlockPool pool);
+inline void BlockPool_resetStats(BlockPool pool);
+
+void BlockPool_clear(BlockPool pool);
+inline void BlockPool_free(BlockPool pool);
+
+inline void* BlockPool_alloc(BlockPool pool);
+inline void BlockPool_release(BlockPool pool, void* block);
+
+#endif // BLOCKPOOL_H
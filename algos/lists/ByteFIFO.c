@@ -20,19 +20,36 @@
  * Creates a new container.
  * @param size  size allocated for data (in bytes)
  * @return      the container created
- * @warning     Memory is allocated with a malloc. You have to set the linker so it allocates at least size + 8 bytes on the heap. You can free the memory with the ByteFIFO_free function.
+ * @warning     Memory is allocated with a malloc. You have to set the linker so it allocates at least size + 12 bytes on the heap (size + 20 with OGBWLIB_LARGE_SIZE). You can free the memory with the ByteFIFO_free function.
  */
-inline ByteFIFO ByteFIFO_new(const U16 size) {
+inline ByteFIFO ByteFIFO_new(const USIZE size) {
     ByteFIFO ret = malloc(sizeof(struct ByteFIFO_struct) + size * sizeof(U8));
     if (ret != null) {
-        ret->size = size;
-        ret->readPtr = 0;
-        ret->writePtr = 0;
-        ret->dataSize = 0;
+        ByteFIFO_init(ret, sizeof(struct ByteFIFO_struct) + size * sizeof(U8));
     }
     return ret;
 }
 
+/**
+ * Creates a new container in a memory area given by the caller, instead of the heap (e.g. in the DMA RAM, so that the DMA can read or write the data directly).
+ * @param memory        memory area, aligned on 2 bytes (4 bytes with OGBWLIB_LARGE_SIZE). The container header is at its beginning, the data just after.
+ * @param memorySize    size of the memory area (in bytes). The size available for data is memorySize minus 12 bytes (20 with OGBWLIB_LARGE_SIZE).
+ * @return              the container created (it is memory itself), null if memorySize is too small to even contain the header
+ * @warning             Don't call ByteFIFO_free on a container created this way.
+ */
+inline ByteFIFO ByteFIFO_init(void* memory, const USIZE memorySize) {
+    ByteFIFO ret = memory;
+    if (memorySize < sizeof(struct ByteFIFO_struct)) {
+        return null;
+    }
+    ret->size = memorySize - sizeof(struct ByteFIFO_struct);
+    ret->readPtr = 0;
+    ret->writePtr = 0;
+    ret->dataSize = 0;
+    ret->dropped = 0;
+    return ret;
+}
+
 /**
  * Checks if the container is empty
  * @return      true if and only if the container is empty
@@ -61,7 +78,7 @@ inline bool ByteFIFO_isFull(const ByteFIFO fifo) {
  * Get the size of the data actually contained
  * @return      size of contained data (in bytes)
  */
-inline U16 ByteFIFO_getDataSize(const ByteFIFO fifo) {
+inline USIZE ByteFIFO_getDataSize(const ByteFIFO fifo) {
     return fifo->dataSize;
 }
 
@@ -69,7 +86,7 @@ inline U16 ByteFIFO_getDataSize(const ByteFIFO fifo) {
  * Get the free space remaining
  * @return      size of the free space (in bytes)
  */
-inline U16 ByteFIFO_getAvailableSize(const ByteFIFO fifo) {
+inline USIZE ByteFIFO_getAvailableSize(const ByteFIFO fifo) {
     return fifo->size - fifo->dataSize;
 }
 
@@ -137,7 +154,7 @@ inline ByteFIFO_Error ByteFIFO_pushByte(ByteFIFO fifo, const S8 data) {
  * @param data	ptr to the data to write
  * @return      ByteFIFO_full if the container was full, or did not has enought free space to write everything. In this case, nothing is written. ByteFIFO_ok otherwise.
  */
-inline ByteFIFO_Error ByteFIFO_pushBlock(ByteFIFO fifo, const U16 size, const void* data) {
+inline ByteFIFO_Error ByteFIFO_pushBlock(ByteFIFO fifo, const USIZE size, const void* data) {
     if (ByteFIFO_getAvailableSize(fifo) >= size) {
         U8* data_ = (U8*) data;
         if (fifo->writePtr + size >= fifo->size) { // writeptr se doit faire un modulo (qu'on doive ou non écrire au début du tableau)
@@ -172,7 +189,7 @@ inline ByteFIFO_Error ByteFIFO_pushStr(ByteFIFO fifo, const void* data) {
  * @return      ByteFIFO_notEnoughtData if the container did not contained as much data as you requested. In this case nothing is read nor removed from the container. ByteFIFO_ok otherwise.
  * @remark      The internal implementation of this function makes it prefectly fine to use it as a 'check if there is at least n bytes and read them if yes'. It is just as efficient as doing it explicitly with ByteFIFO_getDataSize.
  */
-inline ByteFIFO_Error ByteFIFO_popBlock(ByteFIFO fifo, const U16 size, void* data) {
+inline ByteFIFO_Error ByteFIFO_popBlock(ByteFIFO fifo, const USIZE size, void* data) {
     if (ByteFIFO_getDataSize(fifo) >= size) {
         U8* data_ = (U8*) data;
         if (fifo->readPtr + size >= fifo->size) {
@@ -189,3 +206,221 @@ inline ByteFIFO_Error ByteFIFO_popBlock(ByteFIFO fifo, const U16 size, void* dat
         return ByteFIFO_NOT_ENOUGHT_DATA;
     }
 }
+
+/**
+ * Write a byte in the container. If the container is full, the oldest byte is evicted to make room.
+ * @param data	Byte to write
+ * @return      number of bytes evicted (0 or 1).
+ * @remark      The evicted bytes are added to the counter read by ByteFIFO_getDroppedSize.
+ */
+inline USIZE ByteFIFO_pushByteOverwrite(ByteFIFO fifo, const S8 data) {
+    USIZE evicted = 0;
+    if(ByteFIFO_isFull(fifo)) {
+        if(fifo->size == 0) {
+            fifo->dropped++;
+            return 1;
+        }
+        ByteFIFO_pop(fifo);
+        fifo->dropped++;
+        evicted = 1;
+    }
+    ByteFIFO_pushByte(fifo, data);
+    return evicted;
+}
+
+/**
+ * Write several bytes in the container. If there is not enought free space, the oldest bytes are evicted to make room. The write itself never fails.
+ * @param size	size of the data
+ * @param data	ptr to the data to write
+ * @return      number of bytes evicted. If size is greater than the container size, only the last bytes of data are kept, and the skipped ones are counted as evicted too.
+ * @remark      The evicted bytes are added to the counter read by ByteFIFO_getDroppedSize.
+ */
+inline USIZE ByteFIFO_pushBlockOverwrite(ByteFIFO fifo, const USIZE size, const void* data) {
+    USIZE evicted;
+    if(size >= fifo->size) { // everything previously stored is lost, and the container ends up full of the last bytes of data
+        evicted = fifo->dataSize + (size - fifo->size);
+        memcpy(fifo->data, (U8*)data + (size - fifo->size), fifo->size);
+        fifo->readPtr = fifo->writePtr = 0;
+        fifo->dataSize = fifo->size;
+    } else {
+        USIZE available = ByteFIFO_getAvailableSize(fifo);
+        evicted = 0;
+        if(available < size) {
+            evicted = size - available;
+            fifo->readPtr += evicted;
+            if(fifo->readPtr >= fifo->size) {
+                fifo->readPtr -= fifo->size;
+            }
+            fifo->dataSize -= evicted;
+        }
+        ByteFIFO_pushBlock(fifo, size, data);
+    }
+    fifo->dropped += evicted;
+    return evicted;
+}
+
+/**
+ * Get the number of bytes evicted by the overwrite functions.
+ * @return      number of bytes lost since the creation of the container, or the last call to ByteFIFO_resetDroppedSize
+ */
+inline U32 ByteFIFO_getDroppedSize(const ByteFIFO fifo) {
+    return fifo->dropped;
+}
+
+/**
+ * Reset the counter of evicted bytes.
+ * @remark      ByteFIFO_clear does not reset this counter.
+ */
+inline void ByteFIFO_resetDroppedSize(ByteFIFO fifo) {
+    fifo->dropped = 0;
+}
+
+/**
+ * Write as many bytes as possible in the container. Unlike ByteFIFO_pushBlock, a partial write is possible.
+ * @param size	size of the data
+ * @param data	ptr to the data to write
+ * @return      number of bytes actually written (the first ones of data)
+ */
+inline USIZE ByteFIFO_pushAvailable(ByteFIFO fifo, const USIZE size, const void* data) {
+    USIZE available = ByteFIFO_getAvailableSize(fifo);
+    USIZE n = size < available ? size : available;
+    ByteFIFO_pushBlock(fifo, n, data);
+    return n;
+}
+
+/**
+ * Read and remove up to maxSize bytes from the container. Unlike ByteFIFO_popBlock, a partial read is possible: this is the function to use to empty the container in one call.
+ * @param maxSize   size of the buffer
+ * @param data      buffer you want the data to be copied in
+ * @return          number of bytes actually read
+ */
+inline USIZE ByteFIFO_popAvailable(ByteFIFO fifo, const USIZE maxSize, void* data) {
+    USIZE n = fifo->dataSize < maxSize ? fifo->dataSize : maxSize;
+    ByteFIFO_popBlock(fifo, n, data);
+    return n;
+}
+
+/**
+ * Write several blocks of bytes in the container, one after the other, as a single message (e.g. header, payload and CRC): either all of them are written, or none.
+ * @param segments  blocks to write, in order
+ * @param nb        number of blocks
+ * @return          ByteFIFO_FULL if the container did not have enought free space for all the blocks. In this case, nothing is written. ByteFIFO_OK otherwise.
+ * @remark          There is no need to assemble the message in a temporary buffer first, and if the container is shared with an interrupt, a single protection around this call keeps the message in one piece.
+ */
+inline ByteFIFO_Error ByteFIFO_pushVector(ByteFIFO fifo, const ByteFIFO_Segment* segments, const U16 nb) {
+    USIZE total = 0;
+    U16 i;
+    for(i = 0; i < nb; i++) {
+        total += segments[i].size;
+        if(total < segments[i].size) {  // overflow of the total: it can't fit anyway
+            return ByteFIFO_FULL;
+        }
+    }
+    if(ByteFIFO_getAvailableSize(fifo) < total) {
+        return ByteFIFO_FULL;
+    }
+    for(i = 0; i < nb; i++) {
+        ByteFIFO_pushBlock(fifo, segments[i].size, segments[i].data);
+    }
+    return ByteFIFO_OK;
+}
+
+/**
+ * Read and remove up to maxSize bytes from the container, without copying them: todo is called on the contiguous parts of the data, in order, directly in the container memory (twice at most, when the data wraps around the end of the internal array).
+ * @param maxSize   maximum number of bytes to read
+ * @param todo      function to apply : todo(ptr to the first byte, number of bytes). The bytes are removed from the container once it returned.
+ * @return          number of bytes read
+ * @warning         todo must not write in the container.
+ */
+USIZE ByteFIFO_drain(ByteFIFO fifo, const USIZE maxSize, void (*todo)(const void*, USIZE)) {
+    USIZE n = fifo->dataSize < maxSize ? fifo->dataSize : maxSize;
+    USIZE remaining = n;
+    while(remaining != 0) {
+        USIZE span = fifo->size - fifo->readPtr;
+        if(span > remaining) {
+            span = remaining;
+        }
+        todo(fifo->data + fifo->readPtr, span);
+        fifo->readPtr += span;
+        if(fifo->readPtr == fifo->size) {
+            fifo->readPtr = 0;
+        }
+        fifo->dataSize -= span;
+        remaining -= span;
+    }
+    return n;
+}
+
+/**
+ * Get the first contiguous part of the data, without copying nor removing it: the data starts at readPtr and goes up to the end of the internal array at most.
+ * Use it with ByteFIFO_skip to hand the data to a DMA, or to any function working on arrays (CRC, parser...).
+ * @param data  where the ptr to the first byte is written (nothing is written if the container is empty)
+ * @return      number of contiguous bytes available at *data. If it is less than ByteFIFO_getDataSize, the rest of the data is at the beginning of the internal array, call again after ByteFIFO_skip to get it.
+ * @warning     The bytes remain in the container until ByteFIFO_skip is called: pushing can't overwrite them, but clearing or popping the container makes *data invalid.
+ */
+inline USIZE ByteFIFO_getReadSpan(const ByteFIFO fifo, const void** data) {
+    USIZE span = fifo->size - fifo->readPtr;
+    if(fifo->dataSize == 0) {
+        return 0;
+    }
+    *data = fifo->data + fifo->readPtr;
+    return span < fifo->dataSize ? span : fifo->dataSize;
+}
+
+/**
+ * Remove bytes from the container without reading them (typically, the ones given by ByteFIFO_getReadSpan once they are used).
+ * @param size  number of bytes to remove
+ * @return      ByteFIFO_NOT_ENOUGHT_DATA if the container did not contain size bytes. In this case nothing is removed. ByteFIFO_OK otherwise.
+ */
+inline ByteFIFO_Error ByteFIFO_skip(ByteFIFO fifo, const USIZE size) {
+    if(fifo->dataSize < size) {
+        return ByteFIFO_NOT_ENOUGHT_DATA;
+    }
+    fifo->readPtr += size;
+    if(fifo->readPtr >= fifo->size) {
+        fifo->readPtr -= fifo->size;
+    }
+    fifo->dataSize -= size;
+    return ByteFIFO_OK;
+}
+
+/**
+ * Get a contiguous part of the free space, to write in it directly (e.g. formatting text, see Format.c), without an intermediate buffer.
+ * The bytes written there are not in the container until ByteFIFO_publish is called: a message can be written in several parts, and published at once, or given up.
+ * @param offset    number of free bytes to skip (the ones already written since the last publish)
+ * @param data      where the ptr to the first free byte is written (nothing is written if there is no free space after offset)
+ * @return          number of contiguous free bytes at *data. If it is less than ByteFIFO_getAvailableSize - offset, the rest of the free space is at the beginning of the internal array: call again with offset increased by this number.
+ * @warning         Pushing in the container overwrites the bytes written and not published yet.
+ */
+inline USIZE ByteFIFO_getWriteSpan(const ByteFIFO fifo, const USIZE offset, void** data) {
+    USIZE available = fifo->size - fifo->dataSize;
+    USIZE start;
+    USIZE span;
+    if(offset >= available) {
+        return 0;
+    }
+    start = fifo->writePtr + offset;
+    if(start >= fifo->size) {
+        start -= fifo->size;
+    }
+    span = fifo->size - start;
+    *data = fifo->data + start;
+    return span < available - offset ? span : available - offset;
+}
+
+/**
+ * Add to the container the bytes written in the free space (given by ByteFIFO_getWriteSpan).
+ * @param size  number of bytes to add
+ * @return      ByteFIFO_FULL if there was less than size bytes of free space. In this case, nothing is added. ByteFIFO_OK otherwise.
+ */
+inline ByteFIFO_Error ByteFIFO_publish(ByteFIFO fifo, const USIZE size) {
+    if(ByteFIFO_getAvailableSize(fifo) < size) {
+        return ByteFIFO_FULL;
+    }
+    fifo->writePtr += size;
+    if(fifo->writePtr >= fifo->size) {
+        fifo->writePtr -= fifo->size;
+    }
+    fifo->dataSize += size;
+    return ByteFIFO_OK;
+}
@@ -4,10 +4,11 @@
 #include "../../typedef.h"
 
 struct ByteFIFO_struct {
-    U16 size;       /// FIFO size (= max size of the data it can contain
-    U16 readPtr;    /// n° of next byte to read
-    U16 writePtr;   /// n° of next byte to write
-    U16 dataSize;   /// size of actually stored data
+    USIZE size;     /// FIFO size (= max size of the data it can contain
+    USIZE readPtr;  /// n° of next byte to read
+    USIZE writePtr; /// n° of next byte to write
+    USIZE dataSize; /// size of actually stored data
+    U32 dropped;    /// number of bytes evicted by the overwrite functions since creation (or last ByteFIFO_resetDroppedSize)
     S8 data[];      /// data container
 };
 typedef struct ByteFIFO_struct* ByteFIFO;
@@ -18,13 +19,22 @@ typedef enum {
     ByteFIFO_NOT_ENOUGHT_DATA = 2
 } ByteFIFO_Error;
 
-inline ByteFIFO ByteFIFO_new(const U16 size);
+/**
+ * Part of a message to write with ByteFIFO_pushVector.
+ */
+typedef struct {
+    const void* data;   /// ptr to the bytes to write
+    USIZE size;         /// number of bytes
+} ByteFIFO_Segment;
+
+inline ByteFIFO ByteFIFO_new(const USIZE size);
+inline ByteFIFO ByteFIFO_init(void* memory, const USIZE memorySize);
 
 inline bool ByteFIFO_isEmpty(const ByteFIFO fifo);
 inline bool ByteFIFO_isNotEmpty(const ByteFIFO fifo);
 inline bool ByteFIFO_isFull(const ByteFIFO fifo);
-inline U16 ByteFIFO_getDataSize(const ByteFIFO fifo);
-inline U16 ByteFIFO_getAvailableSize(const ByteFIFO fifo);
+inline USIZE ByteFIFO_getDataSize(const ByteFIFO fifo);
+inline USIZE ByteFIFO_getAvailableSize(const ByteFIFO fifo);
 
 inline void ByteFIFO_clear(ByteFIFO fifo);
 inline void ByteFIFO_free(ByteFIFO fifo);
@@ -32,8 +42,21 @@ inline void ByteFIFO_free(ByteFIFO fifo);
 inline S8 ByteFIFO_get(const ByteFIFO fifo);
 inline S8 ByteFIFO_pop(ByteFIFO fifo);
 inline ByteFIFO_Error ByteFIFO_pushByte(ByteFIFO fifo, const S8 data);
-inline ByteFIFO_Error ByteFIFO_pushBlock(ByteFIFO fifo, const U16 size, const void* data);
+inline ByteFIFO_Error ByteFIFO_pushBlock(ByteFIFO fifo, const USIZE size, const void* data);
 inline ByteFIFO_Error ByteFIFO_pushStr(ByteFIFO fifo, const void* data);
-inline ByteFIFO_Error ByteFIFO_popBlock(ByteFIFO fifo, const U16 size, void* data);
+inline ByteFIFO_Error ByteFIFO_popBlock(ByteFIFO fifo, const USIZE size, void* data);
+inline USIZE ByteFIFO_pushAvailable(ByteFIFO fifo, const USIZE size, const void* data);
+inline USIZE ByteFIFO_popAvailable(ByteFIFO fifo, const USIZE maxSize, void* data);
+inline ByteFIFO_Error ByteFIFO_pushVector(ByteFIFO fifo, const ByteFIFO_Segment* segments, const U16 nb);
+USIZE ByteFIFO_drain(ByteFIFO fifo, const USIZE maxSize, void (*todo)(const void*, USIZE));
+inline USIZE ByteFIFO_getReadSpan(const ByteFIFO fifo, const void** data);
+inline ByteFIFO_Error ByteFIFO_skip(ByteFIFO fifo, const USIZE size);
+inline USIZE ByteFIFO_getWriteSpan(const ByteFIFO fifo, const USIZE offset, void** data);
+inline ByteFIFO_Error ByteFIFO_publish(ByteFIFO fifo, const USIZE size);
+
+inline USIZE ByteFIFO_pushByteOverwrite(ByteFIFO fifo, const S8 data);
+inline USIZE ByteFIFO_pushBlockOverwrite(ByteFIFO fifo, const USIZE size, const void* data);
+inline U32 ByteFIFO_getDroppedSize(const ByteFIFO fifo);
+inline void ByteFIFO_resetDroppedSize(ByteFIFO fifo);
 
 #endif // BYTEFIFO_H
@@ -18,7 +18,7 @@
  * @return      un pointeur vers cette LIFO
  * @warning     Il s'agit en arrière plan d'un malloc, il faut donc libérer la mémoire avec ByteLIFO_free.
  */
-inline ByteLIFO ByteLIFO_new(const U16 size) {
+inline ByteLIFO ByteLIFO_new(const USIZE size) {
 	ByteLIFO lifo = (ByteLIFO) malloc(size + sizeof(*lifo));
 	if(lifo != null) {
 		lifo->size = size;
@@ -50,7 +50,7 @@ inline U8 ByteLIFO_isFull(const ByteLIFO lifo) {
  * @param lifo  LIFO à tester
  * @return      Nombre d'octets de données
  */
-inline U16 ByteLIFO_getDataSize(const ByteLIFO lifo) {
+inline USIZE ByteLIFO_getDataSize(const ByteLIFO lifo) {
 	return lifo->next - lifo->data;
 }
 
@@ -59,7 +59,7 @@ inline U16 ByteLIFO_getDataSize(const ByteLIFO lifo) {
  * @param lifo  LIFO à tester
  * @return      Nombre d'octets libres
  */
-inline U16 ByteLIFO_getAvailableSize(const ByteLIFO lifo) {
+inline USIZE ByteLIFO_getAvailableSize(const ByteLIFO lifo) {
 	return lifo->size - (lifo->next - lifo->data);
 }
 
@@ -130,7 +130,7 @@ inline ByteLIFO_Error ByteLIFO_push(ByteLIFO lifo, const U8 data) {
  * @param data	pointeur vers les données à copier
  * @return      ByteLIFO_ok si l'écriture s'est déroulée comme prévu, ByteLIFO_full si la place disponible n'était pas suffisante. Dans ce cas, aucun octet n'est copié.
  */
-inline ByteLIFO_Error ByteLIFO_pushBlock(ByteLIFO lifo, const U16 size, const void* data) {
+inline ByteLIFO_Error ByteLIFO_pushBlock(ByteLIFO lifo, const USIZE size, const void* data) {
 	if(ByteLIFO_getAvailableSize(lifo) < size) {
 		return ByteLIFO_full;
 	}
@@ -146,7 +146,7 @@ inline ByteLIFO_Error ByteLIFO_pushBlock(ByteLIFO lifo, const U16 size, const vo
  * @param data	pointeur vers les données à copier
  * @return      ByteLIFO_ok si l'écriture s'est déroulée comme prévu, ByteLIFO_full si la place disponible n'était pas suffisante. Dans ce cas, aucun octet n'est copié.
  */
-inline ByteLIFO_Error ByteLIFO_rpushBlock(ByteLIFO lifo, const U16 size, const void* data) {
+inline ByteLIFO_Error ByteLIFO_rpushBlock(ByteLIFO lifo, const USIZE size, const void* data) {
 	if(ByteLIFO_getAvailableSize(lifo) < size) {
 		return ByteLIFO_full;
 	}
@@ -166,7 +166,7 @@ inline ByteLIFO_Error ByteLIFO_rpushBlock(ByteLIFO lifo, const U16 size, const v
  * @param data	pointeur vers le buffer dans lequel les données lues sont copiées
  * @return      ByteLIFO_ok si la lecture s'est déroulée comme prévu, ByteLIFO_notEnoughtData si on a essayé de lire plus de données qu'il y en avait disponibles. Dans ce cas, aucun octet n'est lu.
  */
-inline ByteLIFO_Error ByteLIFO_popBlock(ByteLIFO lifo, const U16 size, void* data) {
+inline ByteLIFO_Error ByteLIFO_popBlock(ByteLIFO lifo, const USIZE size, void* data) {
 	if(ByteLIFO_getDataSize(lifo) < size) {
 		return ByteLIFO_notEnoughtData;
 	}
@@ -186,7 +186,7 @@ inline ByteLIFO_Error ByteLIFO_popBlock(ByteLIFO lifo, const U16 size, void* dat
  * @param[out] data	pointeur vers le buffer dans lequel les données lues sont copiées
  * @return      ByteLIFO_ok si la lecture s'est déroulée comme prévu, ByteLIFO_notEnoughtData si on a essayé de lire plus de données qu'il y en avait disponibles. Dans ce cas, aucun octet n'est lu.
  */
-inline ByteLIFO_Error ByteLIFO_rpopBlock(ByteLIFO lifo, const U16 size, void* data) {
+inline ByteLIFO_Error ByteLIFO_rpopBlock(ByteLIFO lifo, const USIZE size, void* data) {
 	if(ByteLIFO_getDataSize(lifo) < size) {
 		return ByteLIFO_notEnoughtData;
 	}
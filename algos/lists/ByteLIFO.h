@@ -1,5 +1,5 @@
 typedef struct {
-	U16 size;   /// Taille de la pile
+	USIZE size; /// Taille de la pile
 	U8* next;   /// Pointeur vers le premier emplacement libre
 	U8 data[];  /// Tableau servant à stocker les données
 }* ByteLIFO;
@@ -10,12 +10,12 @@ typedef enum {
 	ByteLIFO_notEnoughtData
 } ByteLIFO_Error;
 
-inline ByteLIFO ByteLIFO_new(const U16 size);
+inline ByteLIFO ByteLIFO_new(const USIZE size);
 
 inline U8 ByteLIFO_isEmpty(const ByteLIFO lifo);
 inline U8 ByteLIFO_isFull(const ByteLIFO lifo);
-inline U16 ByteLIFO_getDataSize(const ByteLIFO lifo);
-inline U16 ByteLIFO_getAvailableSize(const ByteLIFO lifo);
+inline USIZE ByteLIFO_getDataSize(const ByteLIFO lifo);
+inline USIZE ByteLIFO_getAvailableSize(const ByteLIFO lifo);
 
 inline void ByteLIFO_clear(ByteLIFO lifo);
 inline void ByteLIFO_free(ByteLIFO lifo);
@@ -24,8 +24,8 @@ inline U8 ByteLIFO_get(const ByteLIFO lifo);
 inline U8 ByteLIFO_pop(ByteLIFO lifo);
 inline ByteLIFO_Error ByteLIFO_push(ByteLIFO lifo, const U8 data);
 
-inline ByteLIFO_Error ByteLIFO_pushBlock(ByteLIFO lifo, const U16 size, const void* data);
-inline ByteLIFO_Error ByteLIFO_rpushBlock(ByteLIFO lifo, const U16 size, const void* data);
-inline ByteLIFO_Error ByteLIFO_popBlock(ByteLIFO lifo, const U16 size, void* data);
-inline ByteLIFO_Error ByteLIFO_rpopBlock(ByteLIFO lifo, const U16 size, void* data);
+inline ByteLIFO_Error ByteLIFO_pushBlock(ByteLIFO lifo, const USIZE size, const void* data);
+inline ByteLIFO_Error ByteLIFO_rpushBlock(ByteLIFO lifo, const USIZE size, const void* data);
+inline ByteLIFO_Error ByteLIFO_popBlock(ByteLIFO lifo, const USIZE size, void* data);
+inline ByteLIFO_Error ByteLIFO_rpopBlock(ByteLIFO lifo, const USIZE size, void* data);
 
@@ -0,0 +1,225 @@
+/** @file       HashMap.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  HashMap associates values (pointers) to keys, with lookups in O(1) on average instead of the linear scan of LinkedList_getFilter.
+ *  Keys are either integers (U16 or U32), or byte strings (names, serial numbers...). Both kinds can be mixed in the same map.
+ *  The capacity is fixed at creation (a power of 2) and no allocation is done afterwards. The map can hold capacity-1 keys, but lookups stay fast only while it is less than about 3/4 full.
+ *
+ *  The implementation uses open addressing with linear probing: an entry is stored in the first free slot after the one given by the hash of its key.
+ *  Deletion shifts the following entries back instead of leaving tombstones, so a map that sees a lot of put/remove never degrades.
+ *  Byte-string keys are hashed with FNV-1a. The map only stores a pointer to them: the key must not be modified or freed while it is in the map.
+ *  Just like LinkedList, the map never copies the values, and null cannot be used as a value (it means "not found").
+ *  The implementation offers no garanties against interrupt. If you need to use it on different IPL, protect every call to this library.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "typedef.h"
+#include "HashMap.h"
+
+static inline USIZE home(const HashMap map, U32 key) {
+    key *= 0x9E3779B1UL;    // the low bits of an integer key are often poorly distributed (IDs multiple of 4...)
+    return (USIZE)(key ^ (key >> 16)) & map->mask;
+}
+
+static U32 hashStr(const U8* key, USIZE size) {  // FNV-1a
+    U32 hash = 2166136261UL;
+    while(size-- > 0) {
+        hash ^= *key++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static inline U8 matches(const HashMap_entry* e, const U32 key, const U8* str, const USIZE size) {
+    if(e->key != key || (e->str != str && (e->str == null || str == null))) {
+        return 0;
+    }
+    return str == null || (e->strSize == size && memcmp(e->str, str, size) == 0);
+}
+
+static HashMap_entry* find(const HashMap map, const U32 key, const U8* str, const USIZE size) {   // returns the entry of the key, or the empty slot where it would be
+    USIZE i = home(map, key);
+    HashMap_entry* e = &map->entries[i];
+    while(e->value != null && !matches(e, key, str, size)) {
+        i = (i + 1) & map->mask;
+        e = &map->entries[i];
+    }
+    return e;
+}
+
+static HashMap_Error put(HashMap map, const U32 key, const U8* str, const USIZE size, void* value) {
+    if(value == null) {
+        return HashMap_NULL_VALUE;
+    }
+    HashMap_entry* e = find(map, key, str, size);
+    if(e->value == null) {
+        if(map->size == map->mask) {    // always keep an empty slot, so that the searches stop
+            return HashMap_FULL;
+        }
+        e->key = key;
+        e->str = str;
+        e->strSize = size;
+        map->size++;
+    }
+    e->value = value;
+    return HashMap_OK;
+}
+
+static void* removeEntry(HashMap map, HashMap_entry* e) {
+    void* ret = e->value;
+    USIZE i = e - map->entries;
+    USIZE j = i;
+    if(ret == null) {
+        return null;
+    }
+    map->size--;
+    for(;;) {   // backward shift: move back the following entries that can't be reached anymore because of the hole in i
+        j = (j + 1) & map->mask;
+        if(map->entries[j].value == null) {
+            break;
+        }
+        USIZE h = home(map, map->entries[j].key);
+        if(((j - h) & map->mask) >= ((j - i) & map->mask)) {    // the home of j is not between the hole (excluded) and j
+            map->entries[i] = map->entries[j];
+            i = j;
+        }
+    }
+    map->entries[i].value = null;
+    return ret;
+}
+
+/**
+ * Creates a new map.
+ * @param capacity  number of slots. It is rounded up to the next power of 2, and the map can hold capacity-1 keys.
+ * @return          the map created, null if there was not enought memory
+ * @warning         Memory is allocated with a malloc: 6 + 10*capacity bytes on the target. Use HashMap_init instead if you want a static map.
+ */
+HashMap HashMap_new(const USIZE capacity) {
+    USIZE c = 2;
+    while(c < capacity && c < ((USIZE)1 << (sizeof(USIZE) * 8 - 1))) {
+        c <<= 1;
+    }
+    HashMap ret = malloc(sizeof(struct HashMap_struct) + (U32)c * sizeof(HashMap_entry));
+    if (ret != null) {
+        HashMap_init(ret, (HashMap_entry*)(ret + 1), c);
+    }
+    return ret;
+}
+
+/**
+ * Initialise a map that was not created by HashMap_new, on a buffer provided by the caller.
+ * @param buffer    array of capacity entries, which must live as long as the map
+ * @param capacity  number of slots. It MUST be a power of 2.
+ */
+void HashMap_init(HashMap map, HashMap_entry* buffer, const USIZE capacity) {
+    map->mask = capacity - 1;
+    map->entries = buffer;
+    HashMap_clear(map);
+}
+
+/**
+ * @return number of keys stored
+ */
+inline USIZE HashMap_getSize(const HashMap map) {
+    return map->size;
+}
+
+/**
+ * @return number of slots of the map
+ */
+inline USIZE HashMap_getCapacity(const HashMap map) {
+    return map->mask + 1;
+}
+
+/**
+ * Remove all the keys, in O(capacity). The values are not freed.
+ */
+void HashMap_clear(HashMap map) {
+    USIZE i;
+    for(i = 0; i <= map->mask; i++) {
+        map->entries[i].value = null;
+    }
+    map->size = 0;
+}
+
+/**
+ * Unallocate a map created by HashMap_new. The values are not freed.
+ */
+inline void HashMap_free(HashMap map) {
+    free(map);
+}
+
+/**
+ * Associate a value to an integer key. If the key is already in the map, its value is replaced.
+ * @param key   the key
+ * @param value the value. Can't be null.
+ * @return      HashMap_FULL, HashMap_NULL_VALUE or HashMap_OK
+ */
+HashMap_Error HashMap_put(HashMap map, const U32 key, void* value) {
+    return put(map, key, null, 0, value);
+}
+
+/**
+ * Find the value associated to an integer key.
+ * @param key   the key
+ * @return      the value, null if the key is not in the map
+ */
+void* HashMap_get(const HashMap map, const U32 key) {
+    return find(map, key, null, 0)->value;
+}
+
+/**
+ * Remove an integer key from the map.
+ * @param key   the key
+ * @return      the value that was associated to the key, null if the key was not in the map
+ */
+void* HashMap_remove(HashMap map, const U32 key) {
+    return removeEntry(map, find(map, key, null, 0));
+}
+
+/**
+ * Associate a value to a byte-string key. If the key is already in the map, its value is replaced (but the pointer to the key is not).
+ * @param key   the key. Only the pointer is stored: the key must not be modified or freed while it is in the map.
+ * @param size  size of the key (in bytes)
+ * @param value the value. Can't be null.
+ * @return      HashMap_FULL, HashMap_NULL_VALUE or HashMap_OK
+ */
+HashMap_Error HashMap_putStr(HashMap map, const void* key, const USIZE size, void* value) {
+    return put(map, hashStr(key, size), key, size, value);
+}
+
+/**
+ * Find the value associated to a byte-string key.
+ * @param key   the key. It doesn't have to be the same pointer as the one given to HashMap_putStr, only the same content.
+ * @param size  size of the key (in bytes)
+ * @return      the value, null if the key is not in the map
+ */
+void* HashMap_getStr(const HashMap map, const void* key, const USIZE size) {
+    return find(map, hashStr(key, size), key, size)->value;
+}
+
+/**
+ * Remove a byte-string key from the map.
+ * @param key   the key (same content as the one given to HashMap_putStr)
+ * @param size  size of the key (in bytes)
+ * @return      the value that was associated to the key, null if the key was not in the map
+ */
+void* HashMap_removeStr(HashMap map, const void* key, const USIZE size) {
+    return removeEntry(map, find(map, hashStr(key, size), key, size));
+}
+
+/**
+ * Execute a function on every value of the map, in no particular order.
+ * @param todo  function to execute. It must not add or remove keys.
+ */
+void HashMap_executeAll(const HashMap map, void (*todo)(void*)) {
+    USIZE i;
+    for(i = 0; i <= map->mask; i++) {
+        if(map->entries[i].value != null) {
+            todo(map->entries[i].value);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include "../../typedef.h"
+
+typedef struct {
+    U32 key;            /// integer key, or hash of the byte-string key
+    const U8* str;      /// byte-string key (null for an integer key). Owned by the caller.
+    USIZE strSize;        /// size of the byte-string key
+    void* value;        /// value associated to the key (null if the slot is empty)
+} HashMap_entry;
+
+struct HashMap_struct {
+    USIZE mask;               /// capacity - 1 (the capacity is a power of 2)
+    USIZE size;               /// number of keys stored
+    HashMap_entry* entries; /// slots
+};
+typedef struct HashMap_struct* HashMap;
+
+typedef enum {
+    HashMap_OK = 0,
+    HashMap_FULL = 1,
+    HashMap_NULL_VALUE = 2
+} HashMap_Error;
+
+HashMap HashMap_new(const USIZE capacity);
+void HashMap_init(HashMap map, HashMap_entry* buffer, const USIZE capacity);
+
+inline USIZE HashMap_getSize(const HashMap map);
+inline USIZE HashMap_getCapacity(const HashMap map);
+void HashMap_clear(HashMap map);
+inline void HashMap_free(HashMap map);
+
+HashMap_Error HashMap_put(HashMap map, const U32 key, void* value);
+void* HashMap_get(const HashMap map, const U32 key);
+void* HashMap_remove(HashMap map, const U32 key);
+
+HashMap_Error HashMap_putStr(HashMap map, const void* key, const USIZE size, void* value);
+void* HashMap_getStr(const HashMap map, const void* key, const USIZE size);
+void* HashMap_removeStr(HashMap map, const void* key, const USIZE size);
+
+void HashMap_executeAll(const HashMap map, void (*todo)(void*));
+
+#endif // HASHMAP_H
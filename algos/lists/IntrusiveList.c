@@ -0,0 +1,327 @@
+/** @file       IntrusiveList.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  IntrusiveList is a doubly linked list whose links are stored inside the objects themselves: the type of the objects has to contain an IntrusiveList_node field.
+ *  Compared to LinkedList, there is no item to allocate (adding an object never fails and costs no malloc), traversals read one object instead of an item then its data, and an object can be removed in O(1) from a pointer to itself.
+ *  The drawbacks are that an object can only be in as many lists as it has nodes, and that the list never owns the memory of the objects.
+ *  The implementation offers no garanties against interrupt. If you need to use it on different IPL, protect every call to this library.
+ *
+ *  Example:
+ *      typedef struct { U16 id; IntrusiveList_node link; } Task;
+ *      struct IntrusiveList_struct tasks;
+ *      IntrusiveList_init(&tasks, IntrusiveList_offsetOf(Task, link));
+ *      IntrusiveList_addLast(&tasks, &myTask);
+*/
+
+#include <stdlib.h>
+#include "typedef.h"
+#include "IntrusiveList.h"
+
+#define NODE(list, obj)     ((IntrusiveList_node*)((U8*)(obj) + (list)->offset))
+#define OBJ(list, node)     ((void*)((U8*)(node) - (list)->offset))
+
+/**
+ * Creates a new empty list.
+ * @param offset    position of the node inside the objects, given by IntrusiveList_offsetOf
+ * @return          the list created, null if there was not enought memory
+ * @warning         Memory is allocated with a malloc. Use IntrusiveList_init instead if you want a static list.
+ */
+IntrusiveList IntrusiveList_new(const USIZE offset) {
+    IntrusiveList ret = malloc(sizeof(*ret));
+    if (ret != null) {
+        IntrusiveList_init(ret, offset);
+    }
+    return ret;
+}
+
+/**
+ * Initialise a list that was not created by IntrusiveList_new (global or local variable, field of a struct...).
+ * @param offset    position of the node inside the objects, given by IntrusiveList_offsetOf
+ */
+inline void IntrusiveList_init(IntrusiveList list, const USIZE offset) {
+    list->first = null;
+    list->last = null;
+    list->offset = offset;
+}
+
+/**
+ * Unallocate a list created by IntrusiveList_new. The objects are not freed.
+ */
+inline void IntrusiveList_free(IntrusiveList list) {
+    free(list);
+}
+
+/**
+ * @return true iff the list contains no object
+ */
+inline U8 IntrusiveList_isEmpty(const IntrusiveList list) {
+    return list->first == null;
+}
+
+/**
+ * Count the objects of the list. This function is in O(n).
+ * @return number of objects in the list
+ */
+USIZE IntrusiveList_size(const IntrusiveList list) {
+    USIZE ret = 0;
+    IntrusiveList_node* curr;
+    for(curr = list->first; curr != null; curr = curr->next) {
+        ret++;
+    }
+    return ret;
+}
+
+/**
+ * Add an object at the head of the list.
+ * @param obj   object to add. It must not be in this list already.
+ */
+inline void IntrusiveList_addFirst(IntrusiveList list, void* obj) {
+    IntrusiveList_node* node = NODE(list, obj);
+    node->prev = null;
+    node->next = list->first;
+    if(list->first != null) {
+        list->first->prev = node;
+    } else {
+        list->last = node;
+    }
+    list->first = node;
+}
+
+/**
+ * Add an object at the end of the list.
+ * @param obj   object to add. It must not be in this list already.
+ */
+inline void IntrusiveList_addLast(IntrusiveList list, void* obj) {
+    IntrusiveList_node* node = NODE(list, obj);
+    node->next = null;
+    node->prev = list->last;
+    if(list->last != null) {
+        list->last->next = node;
+    } else {
+        list->first = node;
+    }
+    list->last = node;
+}
+
+/**
+ * Add an object just after another one.
+ * @param ref   object of the list after which obj is inserted
+ * @param obj   object to add. It must not be in this list already.
+ */
+inline void IntrusiveList_addAfter(IntrusiveList list, void* ref, void* obj) {
+    IntrusiveList_node* r = NODE(list, ref);
+    IntrusiveList_node* node = NODE(list, obj);
+    node->prev = r;
+    node->next = r->next;
+    if(r->next != null) {
+        r->next->prev = node;
+    } else {
+        list->last = node;
+    }
+    r->next = node;
+}
+
+/**
+ * Add an object just before another one.
+ * @param ref   object of the list before which obj is inserted
+ * @param obj   object to add. It must not be in this list already.
+ */
+inline void IntrusiveList_addBefore(IntrusiveList list, void* ref, void* obj) {
+    IntrusiveList_node* r = NODE(list, ref);
+    IntrusiveList_node* node = NODE(list, obj);
+    node->next = r;
+    node->prev = r->prev;
+    if(r->prev != null) {
+        r->prev->next = node;
+    } else {
+        list->first = node;
+    }
+    r->prev = node;
+}
+
+/**
+ * Add an object in a sorted list, after the objects that are equal to it.
+ * @param obj       object to add
+ * @param isSmaller order function. isSmaller(a,b) must return true iff a<b.
+ */
+void IntrusiveList_addSorted(IntrusiveList list, void* obj, U8 (*isSmaller)(void*, void*)) {
+    IntrusiveList_node* curr = list->last;
+    while(curr != null && isSmaller(obj, OBJ(list, curr))) {  // from the end, so that sorted inputs are in O(1)
+        curr = curr->prev;
+    }
+    if(curr == null) {
+        IntrusiveList_addFirst(list, obj);
+    } else {
+        IntrusiveList_addAfter(list, OBJ(list, curr), obj);
+    }
+}
+
+/**
+ * @return first object of the list, null if the list is empty
+ */
+inline void* IntrusiveList_getFirst(const IntrusiveList list) {
+    return list->first == null ? null : OBJ(list, list->first);
+}
+
+/**
+ * @return last object of the list, null if the list is empty
+ */
+inline void* IntrusiveList_getLast(const IntrusiveList list) {
+    return list->last == null ? null : OBJ(list, list->last);
+}
+
+/**
+ * @param obj   object of the list
+ * @return      object following obj, null if obj is the last one
+ */
+inline void* IntrusiveList_getNext(const IntrusiveList list, void* obj) {
+    IntrusiveList_node* next = NODE(list, obj)->next;
+    return next == null ? null : OBJ(list, next);
+}
+
+/**
+ * @param obj   object of the list
+ * @return      object preceding obj, null if obj is the first one
+ */
+inline void* IntrusiveList_getPrev(const IntrusiveList list, void* obj) {
+    IntrusiveList_node* prev = NODE(list, obj)->prev;
+    return prev == null ? null : OBJ(list, prev);
+}
+
+/**
+ * Find the first object matching a filter.
+ * @param match filter. match(obj) must return true for the object to return.
+ * @return      object found, null if none matches
+ */
+void* IntrusiveList_getFilter(const IntrusiveList list, U8 (*match)(void*)) {
+    IntrusiveList_node* curr;
+    for(curr = list->first; curr != null; curr = curr->next) {
+        void* obj = OBJ(list, curr);
+        if(match(obj)) {
+            return obj;
+        }
+    }
+    return null;
+}
+
+/**
+ * Remove an object from the list, in O(1).
+ * @param obj   object to remove
+ * @warning     obj must be in this list. There is no way to check it without browsing the list.
+ */
+inline void IntrusiveList_remove(IntrusiveList list, void* obj) {
+    IntrusiveList_node* node = NODE(list, obj);
+    if(node->prev != null) {
+        node->prev->next = node->next;
+    } else {
+        list->first = node->next;
+    }
+    if(node->next != null) {
+        node->next->prev = node->prev;
+    } else {
+        list->last = node->prev;
+    }
+    node->next = null;
+    node->prev = null;
+}
+
+/**
+ * Remove the first object of the list.
+ * @return  object removed, null if the list was empty
+ */
+inline void* IntrusiveList_removeFirst(IntrusiveList list) {
+    void* ret = IntrusiveList_getFirst(list);
+    if(ret != null) {
+        IntrusiveList_remove(list, ret);
+    }
+    return ret;
+}
+
+/**
+ * Remove the last object of the list.
+ * @return  object removed, null if the list was empty
+ */
+inline void* IntrusiveList_removeLast(IntrusiveList list) {
+    void* ret = IntrusiveList_getLast(list);
+    if(ret != null) {
+        IntrusiveList_remove(list, ret);
+    }
+    return ret;
+}
+
+/**
+ * Empty the list in O(1). The nodes of the objects are left as they were, they must not be used before the objects are added to a list again.
+ */
+inline void IntrusiveList_removeAll(IntrusiveList list) {
+    list->first = null;
+    list->last = null;
+}
+
+/**
+ * Remove all the objects matching a filter.
+ * @param match filter. match(obj) must return true for the objects to remove.
+ * @return      number of objects removed
+ */
+USIZE IntrusiveList_removeIf(IntrusiveList list, U8 (*match)(void*)) {
+    USIZE ret = 0;
+    IntrusiveList_node* curr = list->first;
+    while(curr != null) {
+        IntrusiveList_node* next = curr->next;
+        void* obj = OBJ(list, curr);
+        if(match(obj)) {
+            IntrusiveList_remove(list, obj);
+            ret++;
+        }
+        curr = next;
+    }
+    return ret;
+}
+
+/**
+ * Execute a function on every object, from the first to the last.
+ * @param todo  function to execute. It may remove the object it receives from the list.
+ */
+void IntrusiveList_executeAll(const IntrusiveList list, void (*todo)(void*)) {
+    IntrusiveList_node* curr = list->first;
+    while(curr != null) {
+        IntrusiveList_node* next = curr->next;
+        todo(OBJ(list, curr));
+        curr = next;
+    }
+}
+
+/**
+ * Execute a function on every object, from the last to the first.
+ * @param todo  function to execute. It may remove the object it receives from the list.
+ */
+void IntrusiveList_reverseExecuteAll(const IntrusiveList list, void (*todo)(void*)) {
+    IntrusiveList_node* curr = list->last;
+    while(curr != null) {
+        IntrusiveList_node* prev = curr->prev;
+        todo(OBJ(list, curr));
+        curr = prev;
+    }
+}
+
+/**
+ * Execute a function on every object matching a filter.
+ * @param match filter. match(obj) returns true iff todo(obj) must be executed.
+ * @param todo  function to execute. It may remove the object it receives from the list.
+ * @return      number of objects on which todo has been executed
+ */
+USIZE IntrusiveList_executeIf(const IntrusiveList list, U8 (*match)(void*), void (*todo)(void*)) {
+    USIZE ret = 0;
+    IntrusiveList_node* curr = list->first;
+    while(curr != null) {
+        IntrusiveList_node* next = curr->next;
+        void* obj = OBJ(list, curr);
+        if(match(obj)) {
+            todo(obj);
+            ret++;
+        }
+        curr = next;
+    }
+    return ret;
+}
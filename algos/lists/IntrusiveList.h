@@ -0,0 +1,59 @@
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+#include <stddef.h>
+#include "../../typedef.h"
+
+/**
+ * Links to embed in the objects that will be stored in an IntrusiveList.
+ * An object can belong to several lists at the same time if it contains one node per list.
+ */
+typedef struct IntrusiveList_node_ {
+    struct IntrusiveList_node_* next;
+    struct IntrusiveList_node_* prev;
+} IntrusiveList_node;
+
+struct IntrusiveList_struct {
+    IntrusiveList_node* first;  /// node of the first object (null if the list is empty)
+    IntrusiveList_node* last;   /// node of the last object (null if the list is empty)
+    USIZE offset;               /// position of the node inside the objects (see IntrusiveList_offsetOf)
+};
+typedef struct IntrusiveList_struct* IntrusiveList;
+
+/**
+ * Offset to give to IntrusiveList_new or IntrusiveList_init.
+ * @param type      type of the objects stored
+ * @param member    name of the IntrusiveList_node field in this type
+ */
+#define IntrusiveList_offsetOf(type, member) ((USIZE)offsetof(type, member))
+
+IntrusiveList IntrusiveList_new(const USIZE offset);
+inline void IntrusiveList_init(IntrusiveList list, const USIZE offset);
+inline void IntrusiveList_free(IntrusiveList list);
+
+inline U8 IntrusiveList_isEmpty(const IntrusiveList list);
+USIZE IntrusiveList_size(const IntrusiveList list);
+
+inline void IntrusiveList_addFirst(IntrusiveList list, void* obj);
+inline void IntrusiveList_addLast(IntrusiveList list, void* obj);
+inline void IntrusiveList_addAfter(IntrusiveList list, void* ref, void* obj);
+inline void IntrusiveList_addBefore(IntrusiveList list, void* ref, void* obj);
+void IntrusiveList_addSorted(IntrusiveList list, void* obj, U8 (*isSmaller)(void*, void*));
+
+inline void* IntrusiveList_getFirst(const IntrusiveList list);
+inline void* IntrusiveList_getLast(const IntrusiveList list);
+inline void* IntrusiveList_getNext(const IntrusiveList list, void* obj);
+inline void* IntrusiveList_getPrev(const IntrusiveList list, void* obj);
+void* IntrusiveList_getFilter(const IntrusiveList list, U8 (*match)(void*));
+
+inline void IntrusiveList_remove(IntrusiveList list, void* obj);
+inline void* IntrusiveList_removeFirst(IntrusiveList list);
+inline void* IntrusiveList_removeLast(IntrusiveList list);
+inline void IntrusiveList_removeAll(IntrusiveList list);
+USIZE IntrusiveList_removeIf(IntrusiveList list, U8 (*match)(void*));
+
+void IntrusiveList_executeAll(const IntrusiveList list, void (*todo)(void*));
+void IntrusiveList_reverseExecuteAll(const IntrusiveList list, void (*todo)(void*));
+USIZE IntrusiveList_executeIf(const IntrusiveList list, U8 (*match)(void*), void (*todo)(void*));
+
+#endif // INTRUSIVELIST_H
@@ -1,8 +1,24 @@
 #include <stdlib.h>
 #include "typedef.h"
 #include "LinkedList.h"
+#include "BlockPool.h"
 
-void getMeOutOfThisList(volatile LinkedList list, LinkedList_item * curr) {
+static inline LinkedList_item* allocItem(LinkedList list) {
+    if(list->pool != null) {
+        return BlockPool_alloc(list->pool);
+    }
+    return malloc(sizeof(LinkedList_item));
+}//
+
+static inline void freeItem(LinkedList list, LinkedList_item * item) {
+    if(list->pool != null) {
+        BlockPool_release(list->pool, item);
+    } else {
+        free(item);
+    }
+}//
+
+static void getMeOutOfThisList(LinkedList list, LinkedList_item * curr) {
     if(curr == list->first) {	// premier de la liste
         list->first = curr->next;
         if(curr->next != null) {	// cas ou il n'y avait qu'un élément dans la liste (premier et dernier)
@@ -17,34 +33,61 @@ void getMeOutOfThisList(volatile LinkedList list, LinkedList_item * curr) {
         curr->prev->next = curr->next;
         curr->next->prev = curr->prev;
     }
+    list->size--;
+}//
+
+static LinkedList_item * itemAt(LinkedList list, U16 num) { // suppose num < list->size
+    LinkedList_item * curr;
+    U16 i;
+    if(num < list->size/2) {	// on part du bout le plus proche
+        curr = list->first;
+        for(i=0;i<num;i++) {
+            curr = curr->next;
+        }
+    } else {
+        curr = list->last;
+        for(i=list->size-1;i>num;i--) {
+            curr = curr->prev;
+        }
+    }
+    return curr;
+}//
+
+static void insertAfter(LinkedList list, LinkedList_item * curr, LinkedList_item * new) { // curr ne doit pas être le dernier
+    new->prev = curr;
+    new->next = curr->next;
+    curr->next = new;
+    new->next->prev = new;
+    list->size++;
 }//
 
 
 LinkedList LinkedList_new() {
+    return LinkedList_newWithPool(null);
+}//
+
+LinkedList LinkedList_newWithPool(BlockPool pool) {
     LinkedList ret = malloc(sizeof(*ret));
     if(ret != null) {
         ret->first = null;
         ret->last = null;
+        ret->size = 0;
+        ret->pool = pool;
     }
     return ret;
 }//
 
-U16 LinkedList_size(volatile LinkedList list) {
-    U16 size=0;
-    LinkedList_item * curr = list->first;
-    for(;curr!=null;curr=curr->next) {
-        size++;
-    }
-    return size;
+U16 LinkedList_size(LinkedList list) {
+    return list->size;
 }//
 
-U8 LinkedList_isEmpty(volatile LinkedList list) {
+U8 LinkedList_isEmpty(LinkedList list) {
     return list->first==null;
 }//
 
 
-LinkedList_error LinkedList_addFirst(volatile LinkedList list, void* data) {
-    LinkedList_item * new = malloc(sizeof(LinkedList_item));
+LinkedList_error LinkedList_addFirst(LinkedList list, void* data) {
+    LinkedList_item * new = allocItem(list);
     if(new == null) {
         return LINKEDLIST_OUT_OF_MEMORY;
     }
@@ -53,54 +96,43 @@ LinkedList_error LinkedList_addFirst(volatile LinkedList list, void* data) {
     new->next = list->first;
     new->data = data;
 
-    list->first->prev = new;
-    list->first = new;
-    if(new->next == null) {
+    if(list->first != null) {
+        list->first->prev = new;
+    } else {
         list->last = new;
     }
+    list->first = new;
+    list->size++;
 
     return LINKEDLIST_SUCCESS;
 }//
 
-LinkedList_error LinkedList_addMiddle(volatile LinkedList list, void* data, U16 num) { // num correspond à la pos finale, comptée à partir de 0
+LinkedList_error LinkedList_addMiddle(LinkedList list, void* data, U16 num) { // num correspond à la pos finale, comptée à partir de 0
     if(num == 0) {	// cas particulier pénible
         return LinkedList_addFirst(list, data);
     }
 
-    if(LinkedList_isEmpty(list)) { // ce cas passe à travers du filtre ci-dessous
+    if(num > list->size) {
         return LINKEDLIST_OUT_OF_RANGE;
     }
 
-    LinkedList_item * curr = list->first;
-    U16 i;
-    for(i=1;i<num;i++) {
-        if(curr == null) {
-            return LINKEDLIST_OUT_OF_RANGE;
-        }
-        curr = curr->next;
-    }
-
-    if(curr == list->last) {	// cas particulier pénible
+    if(num == list->size) {	// cas particulier pénible
         return LinkedList_addLast(list, data);
     }
 
-    LinkedList_item * new = malloc(sizeof(LinkedList_item));
+    LinkedList_item * new = allocItem(list);
     if(new == null) {
         return LINKEDLIST_OUT_OF_MEMORY;
     }
 
-    new->prev = curr;
-    new->next = curr->next;
     new->data = data;
-
-    curr->next = new;
-    new->next->prev = new;
+    insertAfter(list, itemAt(list, num-1), new);
 
     return LINKEDLIST_SUCCESS;
 }//
 
-LinkedList_error LinkedList_addLast(volatile LinkedList list, void* data) {
-    LinkedList_item * new = malloc(sizeof(LinkedList_item));
+LinkedList_error LinkedList_addLast(LinkedList list, void* data) {
+    LinkedList_item * new = allocItem(list);
     if(new == null) {
         return LINKEDLIST_OUT_OF_MEMORY;
     }
@@ -109,22 +141,24 @@ LinkedList_error LinkedList_addLast(volatile LinkedList list, void* data) {
     new->next = null;
     new->data = data;
 
-    list->last->next = new;
-    list->last = new;
-    if(new->prev == null) {
+    if(list->last != null) {
+        list->last->next = new;
+    } else {
         list->first = new;
     }
+    list->last = new;
+    list->size++;
 
     return LINKEDLIST_SUCCESS;
 }//
 
-LinkedList_error LinkedList_addSorted(volatile LinkedList list, void* data, U8 (*isSmaller)(void*, void*)) { // suppose implicitement que toute la liste est triée
+LinkedList_error LinkedList_addSorted(LinkedList list, void* data, U8 (*isSmaller)(void*, void*)) { // suppose implicitement que toute la liste est triée
     if(LinkedList_isEmpty(list) || isSmaller(data, list->first->data)) {	// liste vide ou placer au début
         return LinkedList_addFirst(list, data);	// isSmaller doit revoyer vrai si =
     } else if(isSmaller(list->last->data, data)) {	// on place à la fin
         return LinkedList_addLast(list, data);
     } else {	// cas général, sauf premier et dernier élément
-        LinkedList_item * new = malloc(sizeof(LinkedList_item));
+        LinkedList_item * new = allocItem(list);
         if(new == null) {
             return LINKEDLIST_OUT_OF_MEMORY;
         }
@@ -134,19 +168,15 @@ LinkedList_error LinkedList_addSorted(volatile LinkedList list, void* data, U8 (
             curr = curr->next;
         }
 
-        new->prev = curr;
-        new->next = curr->next;
         new->data = data;
-
-        curr->next = new;
-        new->next->prev = new;
+        insertAfter(list, curr, new);
 
         return LINKEDLIST_SUCCESS;
     }
 }//
 
 
-void* LinkedList_getFirst(volatile LinkedList list) {
+void* LinkedList_getFirst(LinkedList list) {
     if(LinkedList_isEmpty(list)) {
         return null;
     } else {
@@ -154,20 +184,14 @@ void* LinkedList_getFirst(volatile LinkedList list) {
     }
 }//
 
-void* LinkedList_getMiddle(volatile LinkedList list, U16 num) {
-    LinkedList_item * curr = list->first;
-    U16 i;
-    for(i=0;i<num;i++) {
-        if(curr == null) {
-            return null;
-        }
-        curr = curr->next;
+void* LinkedList_getMiddle(LinkedList list, U16 num) {
+    if(num >= list->size) {
+        return null;
     }
-
-    return curr->data;
+    return itemAt(list, num)->data;
 }//
 
-void* LinkedList_getLast(volatile LinkedList list) {
+void* LinkedList_getLast(LinkedList list) {
     if(LinkedList_isEmpty(list)) {
         return null;
     } else {
@@ -175,7 +199,7 @@ void* LinkedList_getLast(volatile LinkedList list) {
     }
 }//
 
-void* LinkedList_getFilter(volatile LinkedList list, U8 (*match)(void*)) {
+void* LinkedList_getFilter(LinkedList list, U8 (*match)(void*)) {
     LinkedList_item * curr = list->first;
     while(curr!=null) {
         if(match(curr->data)) {
@@ -188,7 +212,7 @@ void* LinkedList_getFilter(volatile LinkedList list, U8 (*match)(void*)) {
 }//
 
 
-void* LinkedList_removeFirst(volatile LinkedList list) {
+void* LinkedList_removeFirst(LinkedList list) {
     if(LinkedList_isEmpty(list)) {
         return null;
     }
@@ -196,27 +220,23 @@ void* LinkedList_removeFirst(volatile LinkedList list) {
 
     void * ret = first->data;
     getMeOutOfThisList(list, first);
-    free(first);
+    freeItem(list, first);
     return ret;
 }//
 
-void* LinkedList_removeMiddle(volatile LinkedList list, U16 num) {
-    LinkedList_item * curr = list->first;
-    U16 i;
-    for(i=0;i<num;i++) {
-        if(curr == null) {
-            return null;
-        }
-        curr = curr->next;
+void* LinkedList_removeMiddle(LinkedList list, U16 num) {
+    if(num >= list->size) {
+        return null;
     }
+    LinkedList_item * curr = itemAt(list, num);
 
     void * ret = curr->data;
     getMeOutOfThisList(list, curr);
-    free(curr);
+    freeItem(list, curr);
     return ret;
 }//
 
-void* LinkedList_removeLast(volatile LinkedList list) {
+void* LinkedList_removeLast(LinkedList list) {
     if(LinkedList_isEmpty(list)) {
         return null;
     }
@@ -224,17 +244,17 @@ void* LinkedList_removeLast(volatile LinkedList list) {
 
     void * ret = last->data;
     getMeOutOfThisList(list, last);
-    free(last);
+    freeItem(list, last);
     return ret;
 }//
 
-void* LinkedList_removePtr(volatile LinkedList list, void* data) {
+void* LinkedList_removePtr(LinkedList list, void* data) {
     LinkedList_item * curr = list->first;
     while(curr!=null) {
         if(curr->data == data) {
             getMeOutOfThisList(list,curr);
             void * ret = curr->data;
-            free(curr);
+            freeItem(list, curr);
             return ret;
         } else {
             curr = curr->next;
@@ -243,13 +263,13 @@ void* LinkedList_removePtr(volatile LinkedList list, void* data) {
     return null;
 }//
 
-void* LinkedList_removeFilter(volatile LinkedList list, U8 (*match)(void*)) {
+void* LinkedList_removeFilter(LinkedList list, U8 (*match)(void*)) {
     LinkedList_item * curr = list->first;
     while(curr!=null) {
         if(match(curr->data)) {
             getMeOutOfThisList(list,curr);
             void * ret = curr->data;
-            free(curr);
+            freeItem(list, curr);
             return ret;
         } else {
             curr = curr->next;
@@ -258,27 +278,28 @@ void* LinkedList_removeFilter(volatile LinkedList list, U8 (*match)(void*)) {
     return null;
 }//
 
-U16 LinkedList_removeAll(volatile LinkedList list) {
+U16 LinkedList_removeAll(LinkedList list) {
     LinkedList_item * curr = list->first;
-    U16 ret=0;
-    while(curr!=null) {
-        getMeOutOfThisList(list,curr);
-        LinkedList_item * tmp=curr;
-        curr = curr->next;
-        free(tmp);
-        ret++;
+    U16 ret = list->size;
+    while(curr!=null) {	// pas besoin de raccrocher les maillons, la liste entière disparait
+        LinkedList_item * next = curr->next;
+        freeItem(list, curr);
+        curr = next;
     }
+    list->first = null;
+    list->last = null;
+    list->size = 0;
     return ret;
 }//
 
-U16 LinkedList_removeAllPtr(volatile LinkedList list, void* data) {
+U16 LinkedList_removeAllPtr(LinkedList list, void* data) {
     LinkedList_item * curr = list->first;
     U16 ret=0;
     while(curr!=null) {
         LinkedList_item * next = curr->next;
         if(curr->data == data) {
             getMeOutOfThisList(list,curr);
-            free(curr);
+            freeItem(list, curr);
             ret++;
         }
         curr=next;
@@ -286,14 +307,14 @@ U16 LinkedList_removeAllPtr(volatile LinkedList list, void* data) {
     return ret;
 }//
 
-U16 LinkedList_removeIf(volatile LinkedList list, U8 (*match)(void*)) {
+U16 LinkedList_removeIf(LinkedList list, U8 (*match)(void*)) {
     LinkedList_item * curr = list->first;
     U16 ret=0;
     while(curr!=null) {
         LinkedList_item * next = curr->next;
         if(match(curr->data)) {
             getMeOutOfThisList(list,curr);
-            free(curr);
+            freeItem(list, curr);
             ret++;
         }
         curr=next;
@@ -302,54 +323,55 @@ U16 LinkedList_removeIf(volatile LinkedList list, U8 (*match)(void*)) {
 }//
 
 
-void LinkedList_deleteFirst(volatile LinkedList list) {
+void LinkedList_deleteFirst(LinkedList list) {
     void * ret = LinkedList_removeFirst(list);
     if(ret != null) {
         free(ret);
     }
 }//
 
-void LinkedList_deleteMiddle(volatile LinkedList list, U16 num) {
+void LinkedList_deleteMiddle(LinkedList list, U16 num) {
     void * ret = LinkedList_removeMiddle(list, num);
     if(ret != null) {
         free(ret);
     }
 }//
 
-void LinkedList_deleteLast(volatile LinkedList list) {
+void LinkedList_deleteLast(LinkedList list) {
     void * ret = LinkedList_removeLast(list);
     if(ret != null) {
         free(ret);
     }
 }//
 
-void LinkedList_deletePtr(volatile LinkedList list, void* data) {
+void LinkedList_deletePtr(LinkedList list, void* data) {
     LinkedList_removePtr(list, data);
     free(data);
 }//
 
-void LinkedList_deleteFilter(volatile LinkedList list, U8 (*match)(void*)) {
+void LinkedList_deleteFilter(LinkedList list, U8 (*match)(void*)) {
     void * ret = LinkedList_removeFilter(list, match);
 	if(ret != null) {
 		free(ret);
 	}
 }//
 
-U16 LinkedList_deleteAll(volatile LinkedList list) {
+U16 LinkedList_deleteAll(LinkedList list) {
     LinkedList_item * curr = list->first;
-    U16 ret=0;
-    while(curr!=null) {
+    U16 ret = list->size;
+    while(curr!=null) {	// pas besoin de raccrocher les maillons, la liste entière disparait
         LinkedList_item * next = curr->next;
-        getMeOutOfThisList(list,curr);
         free(curr->data);
-        free(curr);
-        ret++;
-        curr=next;
+        freeItem(list, curr);
+        curr = next;
     }
+    list->first = null;
+    list->last = null;
+    list->size = 0;
     return ret;
 }//
 
-U16 LinkedList_deleteAllWithDuplicates(volatile LinkedList list){
+U16 LinkedList_deleteAllWithDuplicates(LinkedList list){
     U16 ret=0;
     while(!LinkedList_isEmpty(list)) {
         ret += LinkedList_deleteAllPtr(list, list->first);
@@ -357,12 +379,12 @@ U16 LinkedList_deleteAllWithDuplicates(volatile LinkedList list){
     return ret;
 }
 
-U16 LinkedList_deleteAllPtr(volatile LinkedList list, void* data) {
+U16 LinkedList_deleteAllPtr(LinkedList list, void* data) {
     free(data);
     return LinkedList_removeAllPtr(list, data);
 }
 
-U16 LinkedList_deleteIf(volatile LinkedList list, U8 (*match)(void*)) {
+U16 LinkedList_deleteIf(LinkedList list, U8 (*match)(void*)) {
     LinkedList_item * curr = list->first;
     U16 ret=0;
     while(curr!=null) {
@@ -370,7 +392,7 @@ U16 LinkedList_deleteIf(volatile LinkedList list, U8 (*match)(void*)) {
         if(match(curr->data)) {
             getMeOutOfThisList(list,curr);
             free(curr->data);
-            free(curr);
+            freeItem(list, curr);
             ret++;
         }
         curr = next;
@@ -379,7 +401,7 @@ U16 LinkedList_deleteIf(volatile LinkedList list, U8 (*match)(void*)) {
 }//
 
 
-void LinkedList_executeAll(volatile LinkedList list, void (*todo)(void*)) {
+void LinkedList_executeAll(LinkedList list, void (*todo)(void*)) {
     LinkedList_item * curr = list->first;
     while(curr!=null) {
         todo(curr->data);
@@ -387,7 +409,7 @@ void LinkedList_executeAll(volatile LinkedList list, void (*todo)(void*)) {
     }
 }//
 
-U16 LinkedList_executeIf(volatile LinkedList list, U8 (*match)(void*), void (*todo)(void*)) {
+U16 LinkedList_executeIf(LinkedList list, U8 (*match)(void*), void (*todo)(void*)) {
     LinkedList_item * curr = list->first;
     U16 ret=0;
     while(curr!=null) {
@@ -400,7 +422,7 @@ U16 LinkedList_executeIf(volatile LinkedList list, U8 (*match)(void*), void (*to
     return ret;
 }//
 
-void LinkedList_reverseExecuteAll(volatile LinkedList list, void (*todo)(void*)) {
+void LinkedList_reverseExecuteAll(LinkedList list, void (*todo)(void*)) {
     LinkedList_item * curr = list->last;
     while(curr!=null) {
         todo(curr->data);
@@ -408,7 +430,7 @@ void LinkedList_reverseExecuteAll(volatile LinkedList list, void (*todo)(void*))
     }
 }//
 
-U16 LinkedList_reverseExecuteIf(volatile LinkedList list, U8 (*match)(void*), void (*todo)(void*)) {
+U16 LinkedList_reverseExecuteIf(LinkedList list, U8 (*match)(void*), void (*todo)(void*)) {
     LinkedList_item * curr = list->last;
     U16 ret=0;
     while(curr!=null) {
@@ -479,20 +501,85 @@ LinkedList_error LinkedList_addAllSorted(LinkedList dest, LinkedList src, U8 (*i
     }
 }
 
-LinkedList LinkedList_merge(LinkedList list1, LinkedList list2) {
-    if(LinkedList_isEmpty(list1)) {
-        free(list1);
-        return list2;
-    } else if(LinkedList_isEmpty(list2)) {
-        free(list2);
-        return list1;
+void LinkedList_splice(LinkedList dest, LinkedList src) {
+    if(LinkedList_isEmpty(src)) {
+        return;
+    }
+    if(LinkedList_isEmpty(dest)) {
+        dest->first = src->first;
     } else {
-        list1->last->next = list2->first;
-        list2->first->prev = list1->last;
-        list1->last = list2->last;
-        free(list2);
-        return list1;
+        dest->last->next = src->first;
+        src->first->prev = dest->last;
+    }
+    dest->last = src->last;
+    dest->size += src->size;
+    src->first = null;
+    src->last = null;
+    src->size = 0;
+}
+
+LinkedList LinkedList_merge(LinkedList list1, LinkedList list2) {
+    LinkedList_splice(list1, list2);
+    free(list2);
+    return list1;
+}
+
+static LinkedList_item ** mergeRuns(LinkedList_item ** tail, LinkedList_item * a, LinkedList_item * b, U8 (*isSmaller)(void*, void*)) {
+    while(a!=null && b!=null) {
+        if(isSmaller(b->data, a->data)) {	// à égalité on prend a, ce qui rend le tri stable
+            *tail = b;
+            b = b->next;
+        } else {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = (a!=null) ? a : b;
+    while(*tail != null) {
+        tail = &(*tail)->next;
+    }
+    return tail;
+}
+
+static LinkedList_item * cutAfter(LinkedList_item * curr, U32 n) { // coupe la chaîne après n maillons, renvoie la suite
+    for(;n>1 && curr!=null;n--) {
+        curr = curr->next;
+    }
+    if(curr == null) {
+        return null;
     }
+    LinkedList_item * ret = curr->next;
+    curr->next = null;
+    return ret;
+}
+
+void LinkedList_sort(LinkedList list, U8 (*isSmaller)(void*, void*)) {
+    LinkedList_item * head = list->first;
+    U32 width;
+    if(list->size < 2) {
+        return;
+    }
+    // tri fusion ascendant : on fusionne des séries de 1, 2, 4... maillons, en ne suivant que les next
+    for(width=1;width<list->size;width*=2) {
+        LinkedList_item * rest = head;
+        LinkedList_item ** tail = &head;
+        while(rest != null) {
+            LinkedList_item * left = rest;
+            LinkedList_item * right = cutAfter(left, width);
+            rest = cutAfter(right, width);
+            tail = mergeRuns(tail, left, right, isSmaller);
+        }
+    }
+    // puis on refait les prev en une passe
+    LinkedList_item * prev = null;
+    LinkedList_item * curr;
+    for(curr=head;curr!=null;curr=curr->next) {
+        curr->prev = prev;
+        prev = curr;
+    }
+    list->first = head;
+    list->last = prev;
 }
 
 LinkedList LinkedList_mergeSorted(LinkedList list1, LinkedList list2, U8 (*isSmaller)(void*, void*)) {
@@ -538,8 +625,92 @@ LinkedList LinkedList_mergeSorted(LinkedList list1, LinkedList list2, U8 (*isSma
             curr1->prev = currnew;
         }
 
+        list1->size += list2->size;
         free(list2);
         return list1;
     }
 }
 
+
+LinkedList_cursor LinkedList_cursorFirst(LinkedList list) {
+    LinkedList_cursor ret;
+    ret.list = list;
+    ret.item = list->first;
+    return ret;
+}//
+
+LinkedList_cursor LinkedList_cursorLast(LinkedList list) {
+    LinkedList_cursor ret;
+    ret.list = list;
+    ret.item = list->last;
+    return ret;
+}//
+
+U8 LinkedList_cursorIsValid(const LinkedList_cursor* cursor) {
+    return cursor->item != null;
+}//
+
+U8 LinkedList_cursorNext(LinkedList_cursor* cursor) {
+    if(cursor->item != null) {
+        cursor->item = cursor->item->next;
+    }
+    return cursor->item != null;
+}//
+
+U8 LinkedList_cursorPrev(LinkedList_cursor* cursor) {
+    if(cursor->item != null) {
+        cursor->item = cursor->item->prev;
+    }
+    return cursor->item != null;
+}//
+
+void* LinkedList_cursorGet(const LinkedList_cursor* cursor) {
+    if(cursor->item == null) {
+        return null;
+    }
+    return cursor->item->data;
+}//
+
+LinkedList_error LinkedList_cursorInsertBefore(LinkedList_cursor* cursor, void* data) {
+    if(cursor->item == null) {
+        return LINKEDLIST_OUT_OF_RANGE;
+    }
+    if(cursor->item->prev == null) {
+        return LinkedList_addFirst(cursor->list, data);
+    }
+    LinkedList_item * new = allocItem(cursor->list);
+    if(new == null) {
+        return LINKEDLIST_OUT_OF_MEMORY;
+    }
+    new->data = data;
+    insertAfter(cursor->list, cursor->item->prev, new);
+    return LINKEDLIST_SUCCESS;
+}//
+
+LinkedList_error LinkedList_cursorInsertAfter(LinkedList_cursor* cursor, void* data) {
+    if(cursor->item == null) {
+        return LINKEDLIST_OUT_OF_RANGE;
+    }
+    if(cursor->item->next == null) {
+        return LinkedList_addLast(cursor->list, data);
+    }
+    LinkedList_item * new = allocItem(cursor->list);
+    if(new == null) {
+        return LINKEDLIST_OUT_OF_MEMORY;
+    }
+    new->data = data;
+    insertAfter(cursor->list, cursor->item, new);
+    return LINKEDLIST_SUCCESS;
+}//
+
+void* LinkedList_cursorRemove(LinkedList_cursor* cursor) {
+    LinkedList_item * curr = cursor->item;
+    if(curr == null) {
+        return null;
+    }
+    void * ret = curr->data;
+    cursor->item = curr->next;
+    getMeOutOfThisList(cursor->list, curr);
+    freeItem(cursor->list, curr);
+    return ret;
+}//
@@ -0,0 +1,269 @@
+/** @file       MirrorFIFO.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  MirrorFIFO is a ByteFIFO for Linux host builds (simulation, gateways...), whose memory is mapped twice, back to back, in the virtual address space.
+ *  Reading or writing past the end of the array lands at its beginning, so every region of the FIFO is contiguous: a block is always copied with a single memcpy,
+ *  and a parser (or writev, send...) can work directly on all the stored data through MirrorFIFO_getReadPtr, without caring about the wrap.
+ *  It offers the same functions as ByteFIFO (and the same ByteFIFO_Error codes), plus the zero-copy ones: getReadPtr/skip and getWritePtr/commit.
+ *
+ *  The size is rounded up to a multiple of the page size (4 KiB usually). The memory comes from memfd_create + mmap, so it costs file descriptors only during the creation.
+ *  This file is empty on any other platform than Linux.
+ *  The implementation offers no garanties against concurrent accesses. If you need to use it from several threads, protect every call to this library.
+*/
+
+#ifdef __linux__
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "typedef.h"
+#include "MirrorFIFO.h"
+
+/**
+ * Move a read or write index forward, modulo the size. Internal: not static, as the inline functions of the container call it.
+ */
+void MirrorFIFO_advance(USIZE* ptr, const USIZE n, const USIZE size) {
+    *ptr += n;
+    if(*ptr >= size) {
+        *ptr -= size;
+    }
+}
+
+/**
+ * Creates a new container.
+ * @param size  size allocated for data (in bytes). It is rounded up to a multiple of the page size.
+ * @return      the container created, null if the memory could not be mapped
+ * @remark      Free the memory with the MirrorFIFO_free function.
+ */
+MirrorFIFO MirrorFIFO_new(const USIZE size) {
+    const USIZE page = (USIZE) sysconf(_SC_PAGESIZE);
+    const USIZE s = (size + page - 1) / page * page;
+    MirrorFIFO ret;
+    U8* base;
+    int fd;
+
+    if(s == 0 || s > ((USIZE)-1) / 2) {
+        return null;
+    }
+    ret = malloc(sizeof(struct MirrorFIFO_struct));
+    if(ret == null) {
+        return null;
+    }
+    fd = syscall(SYS_memfd_create, "MirrorFIFO", 0);   // no glibc wrapper before 2.27
+    if(fd < 0) {
+        free(ret);
+        return null;
+    }
+    base = ftruncate(fd, s) != 0 ? MAP_FAILED : mmap(null, 2 * (size_t)s, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);    // reserve the address range
+    if(base == MAP_FAILED
+            || mmap(base, s, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+            || mmap(base + s, s, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        if(base != MAP_FAILED) {
+            munmap(base, 2 * (size_t)s);
+        }
+        close(fd);
+        free(ret);
+        return null;
+    }
+    close(fd);  // the mappings keep the memory alive
+
+    ret->size = s;
+    ret->data = base;
+    MirrorFIFO_clear(ret);
+    return ret;
+}
+
+/**
+ * Unallocate the memory used by this container.
+ */
+void MirrorFIFO_free(MirrorFIFO fifo) {
+    munmap(fifo->data, 2 * (size_t)fifo->size);
+    free(fifo);
+}
+
+/**
+ * @return      true if and only if the container is empty
+ */
+inline bool MirrorFIFO_isEmpty(const MirrorFIFO fifo) {
+    return fifo->dataSize == 0;
+}
+
+/**
+ * @return      true if and only if the container is full
+ */
+inline bool MirrorFIFO_isFull(const MirrorFIFO fifo) {
+    return fifo->dataSize == fifo->size;
+}
+
+/**
+ * @return      size of the container (in bytes), after rounding
+ */
+inline USIZE MirrorFIFO_getSize(const MirrorFIFO fifo) {
+    return fifo->size;
+}
+
+/**
+ * @return      size of contained data (in bytes)
+ */
+inline USIZE MirrorFIFO_getDataSize(const MirrorFIFO fifo) {
+    return fifo->dataSize;
+}
+
+/**
+ * @return      size of the free space (in bytes)
+ */
+inline USIZE MirrorFIFO_getAvailableSize(const MirrorFIFO fifo) {
+    return fifo->size - fifo->dataSize;
+}
+
+/**
+ * Clear the container. The memory is kept.
+ */
+inline void MirrorFIFO_clear(MirrorFIFO fifo) {
+    fifo->readPtr = fifo->writePtr = 0;
+    fifo->dataSize = 0;
+}
+
+/**
+ * Read the first byte contained, without removing it.
+ * @return      Read byte. If the container was empty, it can be anything.
+ */
+inline S8 MirrorFIFO_get(const MirrorFIFO fifo) {
+    return fifo->data[fifo->readPtr];
+}
+
+/**
+ * Read and remove the first byte contained.
+ * @return      Read byte.
+ * @warning     Using this function on an empty container WILL corrupt it.
+ */
+inline S8 MirrorFIFO_pop(MirrorFIFO fifo) {
+    S8 ret = fifo->data[fifo->readPtr];
+    MirrorFIFO_advance(&fifo->readPtr, 1, fifo->size);
+    fifo->dataSize--;
+    return ret;
+}
+
+/**
+ * Write a byte in the container.
+ * @param data	Byte to write
+ * @return      ByteFIFO_FULL if the container was full. In this case, nothing is written. ByteFIFO_OK otherwise.
+ */
+inline ByteFIFO_Error MirrorFIFO_pushByte(MirrorFIFO fifo, const S8 data) {
+    if(fifo->dataSize == fifo->size) {
+        return ByteFIFO_FULL;
+    }
+    fifo->data[fifo->writePtr] = data;
+    MirrorFIFO_advance(&fifo->writePtr, 1, fifo->size);
+    fifo->dataSize++;
+    return ByteFIFO_OK;
+}
+
+/**
+ * Write several bytes in the container, with a single memcpy.
+ * @param size	size of the data
+ * @param data	ptr to the data to write
+ * @return      ByteFIFO_FULL if there was not enought free space to write everything. In this case, nothing is written. ByteFIFO_OK otherwise.
+ */
+inline ByteFIFO_Error MirrorFIFO_pushBlock(MirrorFIFO fifo, const USIZE size, const void* data) {
+    if(MirrorFIFO_getAvailableSize(fifo) < size) {
+        return ByteFIFO_FULL;
+    }
+    memcpy(fifo->data + fifo->writePtr, data, size);
+    MirrorFIFO_commit(fifo, size);
+    return ByteFIFO_OK;
+}
+
+/**
+ * Write a string in the container.
+ * @param data	string to write
+ * @return      ByteFIFO_FULL if there was not enought free space to write everything. In this case, nothing is written. ByteFIFO_OK otherwise.
+ */
+inline ByteFIFO_Error MirrorFIFO_pushStr(MirrorFIFO fifo, const void* data) {
+    return MirrorFIFO_pushBlock(fifo, strlen(data), data);
+}
+
+/**
+ * Read and remove several bytes from the container, with a single memcpy.
+ * @param size  number of bytes to read
+ * @param data  buffer you want the data to be copied in
+ * @return      ByteFIFO_NOT_ENOUGHT_DATA if the container did not contain as much data as requested. In this case nothing is read. ByteFIFO_OK otherwise.
+ */
+inline ByteFIFO_Error MirrorFIFO_popBlock(MirrorFIFO fifo, const USIZE size, void* data) {
+    if(fifo->dataSize < size) {
+        return ByteFIFO_NOT_ENOUGHT_DATA;
+    }
+    memcpy(data, fifo->data + fifo->readPtr, size);
+    MirrorFIFO_skip(fifo, size);
+    return ByteFIFO_OK;
+}
+
+/**
+ * Write as many bytes as possible in the container.
+ * @param size	size of the data
+ * @param data	ptr to the data to write
+ * @return      number of bytes actually written (the first ones of data)
+ */
+inline USIZE MirrorFIFO_pushAvailable(MirrorFIFO fifo, const USIZE size, const void* data) {
+    USIZE available = MirrorFIFO_getAvailableSize(fifo);
+    USIZE n = size < available ? size : available;
+    MirrorFIFO_pushBlock(fifo, n, data);
+    return n;
+}
+
+/**
+ * Read and remove up to maxSize bytes from the container.
+ * @param maxSize   size of the buffer
+ * @param data      buffer you want the data to be copied in
+ * @return          number of bytes actually read
+ */
+inline USIZE MirrorFIFO_popAvailable(MirrorFIFO fifo, const USIZE maxSize, void* data) {
+    USIZE n = fifo->dataSize < maxSize ? fifo->dataSize : maxSize;
+    MirrorFIFO_popBlock(fifo, n, data);
+    return n;
+}
+
+/**
+ * Get a ptr to the data stored, to read (or parse, send...) them in place.
+ * @return      ptr to the first byte. The MirrorFIFO_getDataSize(fifo) bytes that follow are the whole content of the container, contiguous.
+ * @remark      Remove the bytes once processed with MirrorFIFO_skip.
+ */
+inline const void* MirrorFIFO_getReadPtr(const MirrorFIFO fifo) {
+    return fifo->data + fifo->readPtr;
+}
+
+/**
+ * Remove bytes from the container without reading them.
+ * @param size  number of bytes to remove. Must not be greater than MirrorFIFO_getDataSize(fifo).
+ */
+inline void MirrorFIFO_skip(MirrorFIFO fifo, const USIZE size) {
+    MirrorFIFO_advance(&fifo->readPtr, size, fifo->size);
+    fifo->dataSize -= size;
+}
+
+/**
+ * Get a ptr to the free space of the container, to write (or recv, read...) data in place.
+ * @return      ptr to the first free byte. The MirrorFIFO_getAvailableSize(fifo) bytes that follow are the whole free space, contiguous.
+ * @remark      Make the bytes written part of the content with MirrorFIFO_commit.
+ */
+inline void* MirrorFIFO_getWritePtr(const MirrorFIFO fifo) {
+    return fifo->data + fifo->writePtr;
+}
+
+/**
+ * Add to the content the bytes written through MirrorFIFO_getWritePtr.
+ * @param size  number of bytes written. Must not be greater than MirrorFIFO_getAvailableSize(fifo).
+ */
+inline void MirrorFIFO_commit(MirrorFIFO fifo, const USIZE size) {
+    MirrorFIFO_advance(&fifo->writePtr, size, fifo->size);
+    fifo->dataSize += size;
+}
+
+#endif // __linux__
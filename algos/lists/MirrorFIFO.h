@@ -0,0 +1,44 @@
+#ifndef MIRRORFIFO_H
+#define MIRRORFIFO_H
+
+#ifdef __linux__
+
+#include "../../typedef.h"
+#include "ByteFIFO.h"
+
+struct MirrorFIFO_struct {
+    USIZE size;     /// FIFO size, a multiple of the page size
+    USIZE readPtr;  /// n° of next byte to read
+    USIZE writePtr; /// n° of next byte to write
+    USIZE dataSize; /// size of actually stored data
+    U8* data;       /// data container, mapped twice: data[i] and data[i + size] are the same byte
+};
+typedef struct MirrorFIFO_struct* MirrorFIFO;
+
+MirrorFIFO MirrorFIFO_new(const USIZE size);
+void MirrorFIFO_free(MirrorFIFO fifo);
+
+inline bool MirrorFIFO_isEmpty(const MirrorFIFO fifo);
+inline bool MirrorFIFO_isFull(const MirrorFIFO fifo);
+inline USIZE MirrorFIFO_getSize(const MirrorFIFO fifo);
+inline USIZE MirrorFIFO_getDataSize(const MirrorFIFO fifo);
+inline USIZE MirrorFIFO_getAvailableSize(const MirrorFIFO fifo);
+inline void MirrorFIFO_clear(MirrorFIFO fifo);
+
+inline S8 MirrorFIFO_get(const MirrorFIFO fifo);
+inline S8 MirrorFIFO_pop(MirrorFIFO fifo);
+inline ByteFIFO_Error MirrorFIFO_pushByte(MirrorFIFO fifo, const S8 data);
+inline ByteFIFO_Error MirrorFIFO_pushBlock(MirrorFIFO fifo, const USIZE size, const void* data);
+inline ByteFIFO_Error MirrorFIFO_pushStr(MirrorFIFO fifo, const void* data);
+inline ByteFIFO_Error MirrorFIFO_popBlock(MirrorFIFO fifo, const USIZE size, void* data);
+inline USIZE MirrorFIFO_pushAvailable(MirrorFIFO fifo, const USIZE size, const void* data);
+inline USIZE MirrorFIFO_popAvailable(MirrorFIFO fifo, const USIZE maxSize, void* data);
+
+inline const void* MirrorFIFO_getReadPtr(const MirrorFIFO fifo);
+inline void MirrorFIFO_skip(MirrorFIFO fifo, const USIZE size);
+inline void* MirrorFIFO_getWritePtr(const MirrorFIFO fifo);
+inline void MirrorFIFO_commit(MirrorFIFO fifo, const USIZE size);
+
+#endif // __linux__
+
+#endif // MIRRORFIFO_H
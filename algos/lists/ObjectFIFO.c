@@ -7,6 +7,13 @@
  * Un objet est une suite d'octets quelconque. Le plus souvent, il s'agira d'une structure. La mémoire est organisée de façon à ce qu'on puisse lire l'objet à partir d'un pointeur. L'ordre les octets représentant les object n'est pas affecté.
  * Par file, on entend une liste FIFO (first in first out). Les objets sont lus dans le même ordre qu'ils sont ajoutés.
  * Le système ne prévois pas en lui-même une protection contre les interruptions. La meilleure méthode est a priori de protéger toutes les fonctions d'ajout ou de lecture de données.
+ * Les fonctions ObjectFIFO_pushOverwrite et ObjectFIFO_allocateOverwrite permettent d'utiliser la file comme un anneau : quand la place manque, les objets les plus anciens sont retirés (en entier) pour faire de la place, et comptés (cf ObjectFIFO_getDroppedNb).
+ *
+ * Exception à la règle précédente : avec un seul écrivain et un seul lecteur (typiquement une interruption qui produit des messages, et la boucle principale qui les consomme), aucune protection n'est nécessaire si on utilise :
+ *  - côté écrivain : ObjectFIFO_claim, on remplit l'objet, puis ObjectFIFO_publish (ou ObjectFIFO_push, qui fait les trois)
+ *  - côté lecteur : ObjectFIFO_borrow, on traite l'objet, puis ObjectFIFO_release
+ * L'écrivain ne modifie que write, claimed et pushNb, le lecteur que read et popNb. Un objet n'est visible du lecteur qu'une fois publié, et sa place n'est réutilisée qu'une fois libérée, ce qui permet de travailler directement dans la file sans recopie.
+ * Les fonctions *Overwrite retirent des objets : elles font de l'écrivain un second lecteur, et ne peuvent donc pas être utilisées ainsi.
 */
 
 #include <stdlib.h>
@@ -14,24 +21,37 @@
 #include "typedef.h"
 #include "ObjectFIFO.h"
 
-#define ALIGN_ATTRIBUTE __attribute__((aligned(2)))
-#define ALIGN(x)        (((x)+1) 	& 0b1111111111111110)
+#define ALIGNMENT       sizeof(USIZE)   // les blocs sont alignés pour que leur champ next le soit
+#define ALIGN(x)        (((x)+ALIGNMENT-1) & ~(USIZE)(ALIGNMENT-1))
+
+#define NO_BLOCK        ((USIZE)-1)     // valeur de claimed quand aucun bloc n'est réservé
+#define WRAP_MARK       ((USIZE)-1)     // valeur de next pour une marque de retour au début du tableau
+
+// Empêche le compilateur (et le processeur, sur une machine multi-coeurs) de réordonner les accès mémoire de part et d'autre.
+// Sur dsPIC, les écritures 16 bits alignées sont atomiques et il n'y a qu'un coeur : une barrière de compilation suffit.
+#if defined(__XC16__) || defined(__C30__)
+#define MEMORY_BARRIER()    __asm__ volatile ("" ::: "memory")
+#else
+#define MEMORY_BARRIER()    __sync_synchronize()
+#endif
 
 /**
  * Crée une nouvelle FIFO.
- * @param size  taille maximale des données à stoquer (en octets). Cette taille doit contenir aussi les données maintenant la liste (2 à 3 octets par objet)
+ * @param size  taille maximale des données à stoquer (en octets), arrondie au multiple de sizeof(USIZE) inférieur. Cette taille doit contenir aussi les données maintenant la liste (sizeof(ObjectFIFO_Elem) octets par objet, plus l'alignement des objets)
  * @return      un pointeur vers cette FIFO
  * @warning     Il s'agit en arrière plan d'un malloc, il faut donc libérer la mémoire avec ObjectFIFO_free.
  *
  * Le dimensionnement se fait ainsi : à tout instant, il faut vérifier
- *  size >= 3*(nb+1) + somme(j=1..nb, Sj) + max(j=1..nb, Sj)
+ *  size >= (nb+1)*sizeof(ObjectFIFO_Elem) + somme(j=1..nb, A(Sj)) + max(j=1..nb, A(Sj))
  *  où  nb est le nombre d'éléments de la file
  *      Sj est la taille du j-ième élément
+ *      A(x) est x arrondi au multiple de sizeof(USIZE) supérieur (sizeof(ObjectFIFO_Elem) = sizeof(USIZE) : 2 octets sur dsPIC, 4 sur PC)
  */
-inline ObjectFIFO ObjectFIFO_new(U16 size) {
-    ObjectFIFO fifo = malloc(sizeof(*fifo));
+inline ObjectFIFO ObjectFIFO_new(USIZE size) {
+    ObjectFIFO fifo = malloc(sizeof(*fifo) + size);
     if(fifo != null) {
-        fifo->size = size;
+        fifo->size = size & ~(USIZE)(ALIGNMENT-1); // tous les blocs sont alignés, les octets en trop en fin de tableau seraient inutilisables
+        fifo->dropped = 0;
         ObjectFIFO_clear(fifo);
     }
     return fifo;
@@ -43,7 +63,7 @@ inline ObjectFIFO ObjectFIFO_new(U16 size) {
  * @return      vrai si et seulement si la FIFO est vide
  */
 inline U8 ObjectFIFO_isEmpty(const ObjectFIFO fifo) {
-    return fifo->objNb == 0;
+    return fifo->pushNb == fifo->popNb;
 }
 
 /**
@@ -61,9 +81,9 @@ inline U8 ObjectFIFO_isFull(const ObjectFIFO fifo) {
  * @return      Nombre d'octets libres
  * @warning     La taille renvoyée n'est pas nécessairement utilisable. Cela dépend de la façon dont sont rangés les données.
  */
-inline U16 ObjectFIFO_getAvailableSize(const ObjectFIFO fifo) {
+inline USIZE ObjectFIFO_getAvailableSize(const ObjectFIFO fifo) {
     if(fifo->read == fifo->write) {
-        return fifo->objNb==0?fifo->size:0;
+        return ObjectFIFO_isEmpty(fifo)?fifo->size:0;
     } else if(fifo->read < fifo->write) {
         return fifo->size + fifo->read - fifo->write;
     } else {
@@ -76,9 +96,9 @@ inline U16 ObjectFIFO_getAvailableSize(const ObjectFIFO fifo) {
  * @param fifo  FIFO à tester
  * @return      Nombre d'octets de données. Comprends la mémoire utilisée pour la gestion de la file.
  */
-inline U16 ObjectFIFO_getAllocatedSize(const ObjectFIFO fifo) {
+inline USIZE ObjectFIFO_getAllocatedSize(const ObjectFIFO fifo) {
     if(fifo->read == fifo->write) {
-        return fifo->objNb==0?0:fifo->size;
+        return ObjectFIFO_isEmpty(fifo)?0:fifo->size;
     } else if(fifo->read > fifo->write) {
         return fifo->size + fifo->write - fifo->read;
     } else {
@@ -91,8 +111,8 @@ inline U16 ObjectFIFO_getAllocatedSize(const ObjectFIFO fifo) {
  * @param fifo  FIFO à tester
  * @return      Nombre d'objets.
  */
-inline U16 ObjectFIFO_getObjectNb(const ObjectFIFO fifo) {
-    return fifo->objNb;
+inline USIZE ObjectFIFO_getObjectNb(const ObjectFIFO fifo) {
+    return (USIZE)(fifo->pushNb - fifo->popNb);
 }
 
 /**
@@ -103,7 +123,9 @@ inline U16 ObjectFIFO_getObjectNb(const ObjectFIFO fifo) {
 inline void ObjectFIFO_clear(ObjectFIFO fifo) {
     fifo->write = 0;
     fifo->read = 0;
-    fifo->objNb = 0;
+    fifo->claimed = NO_BLOCK;
+    fifo->pushNb = 0;
+    fifo->popNb = 0;
 }
 
 /**
@@ -115,34 +137,50 @@ inline void ObjectFIFO_free(ObjectFIFO fifo) {
     free(fifo);
 }
 
+/**
+ * Trouve le premier bloc de la FIFO, en sautant l'éventuelle marque de retour au début du tableau. Réservé au lecteur.
+ * @param fifo  FIFO à lire
+ * @return      premier bloc, null si la file était vide
+ * @remark      Interne : pas static, car appelée par les fonctions inline de la FIFO.
+ */
+ObjectFIFO_Elem* ObjectFIFO_head(ObjectFIFO fifo) {
+    ObjectFIFO_Elem* elem;
+    if(ObjectFIFO_isEmpty(fifo)) {
+        return null;
+    }
+    MEMORY_BARRIER();   // le contenu du bloc ne doit pas être lu avant pushNb
+    elem = (ObjectFIFO_Elem*)(fifo->data + fifo->read);
+    if(elem->next == WRAP_MARK) {
+        fifo->read = 0;
+        elem = (ObjectFIFO_Elem*)fifo->data;
+    }
+    return elem;
+}
+
 /**
  * Renvoie un pointeur vers le premier objet de la FIFO. Contrairement à ObjectFIFO_pop, il n'est pas retiré de la FIFO.
  * @param fifo  FIFO à lire
  * @return      Objet lu, null si la file était vide
  */
 inline void* ObjectFIFO_get(const ObjectFIFO fifo) {
-    if(!ObjectFIFO_isEmpty(fifo)) {
-        return fifo->data + fifo->read + offsetof(ObjectFIFO_Elem, data);
-    } else {
-        return null;
-    }
+    return ObjectFIFO_borrow(fifo);
 }
 
 /**
  * Renvoie un pointeur vers le premier objet de la FIFO. Contrairement à ObjectFIFO_get, l'objet est retiré de la FIFO.
  * @param fifo  FIFO à lire
  * @return      Octet lu
- * @warning	Le pointeur renvoyé est valide pour accéder aux donnée que dans la mesure où aucune donnée n'est écrite par dessus, ce qui n'est garanti que tant qu'on n'ajoute pas d'objet dans la pile. Si le programme ne garantie pas une parfaite maitrise des ajouts dans la file, il vaudra mieux utiliser ObjectFIFO_get, puis ObjectFIFO_pop une fois qu'on a fini de traiter les données.
+ * @warning	Le pointeur renvoyé est valide pour accéder aux donnée que dans la mesure où aucune donnée n'est écrite par dessus, ce qui n'est garanti que tant qu'on n'ajoute pas d'objet dans la pile. Si le programme ne garantie pas une parfaite maitrise des ajouts dans la file, il vaudra mieux utiliser ObjectFIFO_borrow, puis ObjectFIFO_release une fois qu'on a fini de traiter les données.
  */
 inline void* ObjectFIFO_pop(ObjectFIFO fifo) {
-    if(ObjectFIFO_isEmpty(fifo)) {
+    ObjectFIFO_Elem* elem = ObjectFIFO_head(fifo);
+    if(elem == null) {
         return null;
-    } else {
-        ObjectFIFO_Elem* elem = (ObjectFIFO_Elem*)(fifo->data+fifo->read);
-        fifo->read = elem->next;
-        fifo->objNb--;
-        return elem->data;
     }
+    fifo->read = elem->next;
+    MEMORY_BARRIER();
+    fifo->popNb++;
+    return elem->data;
 }
 
 /**
@@ -152,30 +190,121 @@ inline void* ObjectFIFO_pop(ObjectFIFO fifo) {
  * @param data	Object a àjouter
  * @return      Pointeur vers la copie de l'objet dans la FIFO. null s'il n'y avait pas assez de place
  */
-inline void* ObjectFIFO_push(ObjectFIFO fifo, const U16 size, const void* data) {
-    U8* blockData = (U8*) ObjectFIFO_allocate(fifo, size);
+inline void* ObjectFIFO_push(ObjectFIFO fifo, const USIZE size, const void* data) {
+    U8* blockData = (U8*) ObjectFIFO_claim(fifo, size);
     if(blockData == null) {
         return null;
     }
     memcpy(blockData, data, size);
+    ObjectFIFO_publish(fifo);
     return blockData;
 }
 
 /**
  * Réserve la place pour ajouter un objet dans la FIFO. Cette méthode peut être utile si on veut placer un objet dans la file dont on ne connais pas le contenu. Il suffira d'écrire dedans plus tard grâce au pointeur retourné. Par contre, il faudra faire attention à ne pas risquer de lire un objet pas encore initialisé.
+ * @sa          ObjectFIFO_claim et ObjectFIFO_publish, qui ne rendent l'objet visible qu'une fois rempli.
  * @param fifo  FIFO dans laquelle écrire
  * @param size  Taille de la méméoire à réserver
  * @return      Pointeur vers la mémoire allouée dans la FIFO. null s'il n'y avait pas assez de place
  */
-void* ObjectFIFO_allocate(ObjectFIFO fifo, const U16 size) {
-    const U16 neededSize = ALIGN(sizeof(ObjectFIFO_Elem) + size);
+void* ObjectFIFO_allocate(ObjectFIFO fifo, const USIZE size) {
+    void* block = ObjectFIFO_claim(fifo, size);
+    if(block != null) {
+        ObjectFIFO_publish(fifo);
+    }
+    return block;
+}
+
+/**
+ * Ajoute un objet dans la FIFO. S'il n'y a pas assez de place, les objets les plus anciens sont retirés de la file jusqu'à ce que le nouvel objet puisse être écrit.
+ * @param fifo  FIFO dans laquelle écrire
+ * @param size  Taille de l'objet
+ * @param data	Object a àjouter
+ * @return      Pointeur vers la copie de l'objet dans la FIFO. null si l'objet est trop gros pour la FIFO, même vide (dans ce cas, rien n'est retiré).
+ * @warning     Les pointeurs obtenus précédemment par ObjectFIFO_get ou ObjectFIFO_pop peuvent désigner un objet écrasé.
+ */
+inline void* ObjectFIFO_pushOverwrite(ObjectFIFO fifo, const USIZE size, const void* data) {
+    U8* blockData = (U8*) ObjectFIFO_allocateOverwrite(fifo, size);
+    if(blockData == null) {
+        return null;
+    }
+    memcpy(blockData, data, size);
+    return blockData;
+}
+
+/**
+ * Réserve la place pour ajouter un objet dans la FIFO, en retirant les objets les plus anciens si nécessaire. Cf ObjectFIFO_allocate et ObjectFIFO_pushOverwrite.
+ * @param fifo  FIFO dans laquelle écrire
+ * @param size  Taille de la méméoire à réserver
+ * @return      Pointeur vers la mémoire allouée dans la FIFO. null si l'objet est trop gros pour la FIFO, même vide (dans ce cas, rien n'est retiré).
+ */
+void* ObjectFIFO_allocateOverwrite(ObjectFIFO fifo, const USIZE size) {
+    void* block;
+    if(ALIGN(sizeof(ObjectFIFO_Elem) + size) > fifo->size) {
+        return null;
+    }
+    while((block = ObjectFIFO_allocate(fifo, size)) == null) {
+        if(ObjectFIFO_isEmpty(fifo)) {  // le bloc ne tient ni après write ni avant : on repart du début du tableau, où il tient forcément
+            ObjectFIFO_clear(fifo);
+        } else {
+            ObjectFIFO_pop(fifo);
+            fifo->dropped++;
+        }
+    }
+    return block;
+}
+
+/**
+ * Détermine le nombre d'objets retirés par les fonctions *Overwrite
+ * @param fifo  FIFO à tester
+ * @return      Nombre d'objets perdus depuis la création de la FIFO ou le dernier appel à ObjectFIFO_resetDroppedNb.
+ */
+inline U32 ObjectFIFO_getDroppedNb(const ObjectFIFO fifo) {
+    return fifo->dropped;
+}
+
+/**
+ * Remet à zéro le compteur d'objets perdus
+ * @param fifo  FIFO concernée
+ * @remark      ObjectFIFO_clear ne remet pas ce compteur à zéro.
+ */
+inline void ObjectFIFO_resetDroppedNb(ObjectFIFO fifo) {
+    fifo->dropped = 0;
+}
+
+/**
+ * Réserve la place pour ajouter un objet dans la FIFO, sans le rendre visible du lecteur. On remplit l'objet grâce au pointeur retourné, puis on le publie avec ObjectFIFO_publish.
+ * Un seul objet peut être réservé à la fois : réserver à nouveau avant de publier annule la réservation précédente.
+ * @param fifo  FIFO dans laquelle écrire
+ * @param size  Taille de la méméoire à réserver
+ * @return      Pointeur vers la mémoire réservée dans la FIFO. null s'il n'y avait pas assez de place
+ * @remark      Ne modifie que les champs de l'écrivain : peut être appelée sans protection pendant que le lecteur utilise ObjectFIFO_borrow/ObjectFIFO_release.
+ */
+void* ObjectFIFO_claim(ObjectFIFO fifo, const USIZE size) {
+    const USIZE neededSize = ALIGN(sizeof(ObjectFIFO_Elem) + size);
     ObjectFIFO_Elem* block;
-    U16 blockPtr;
+    USIZE blockPtr, end, read, objNb;
+
+    if(neededSize > fifo->size) {
+        return null;
+    }
 
-    if(fifo->objNb==0) {
-        blockPtr = 0;
-    } else if(fifo->write <= fifo->read) {
-        if((U8*)fifo->write + neededSize <= (U8*)fifo->read) {
+    objNb = fifo->pushNb - fifo->popNb;
+    MEMORY_BARRIER();   // read doit être lu après popNb : le lecteur fait l'inverse
+    read = fifo->read;
+
+    if(objNb == 0) {    // le lecteur a tout libéré, read == write
+        if(fifo->write + neededSize <= fifo->size) {
+            blockPtr = fifo->write;
+        } else if(neededSize <= fifo->write) {  // le lecteur trouvera la marque de retour en read (= write) : le bloc ne doit pas la recouvrir
+            blockPtr = 0;
+        } else {
+            return null;
+        }
+    } else if(fifo->write == read) {  // pleine
+        return null;
+    } else if(fifo->write < read) {
+        if(fifo->write + neededSize <= read) {
             blockPtr = fifo->write;
         } else {
             return null;
@@ -183,28 +312,142 @@ void* ObjectFIFO_allocate(ObjectFIFO fifo, const U16 size) {
     } else { //write > read
         if(fifo->write + neededSize <= fifo->size) {  // assez de place à la fin du tableau
             blockPtr = fifo->write;
-        } else if(neededSize <= fifo->read) { // assez de place au début du tableau
+        } else if(neededSize <= read) { // assez de place au début du tableau
             blockPtr = 0;
         } else {
             return null;
         }
     }
 
+    if(blockPtr != fifo->write) {   // on repart au début du tableau : le lecteur doit le savoir
+        ((ObjectFIFO_Elem*)(fifo->data + fifo->write))->next = WRAP_MARK;
+    }
+
+    end = blockPtr + neededSize;
     block = (ObjectFIFO_Elem*)(fifo->data + blockPtr);
+    block->next = end == fifo->size ? 0 : end;
+    fifo->claimed = blockPtr;
 
-    if(fifo->objNb == 0) {
-        fifo->read = blockPtr;
-    } else {
-        fifo->lastWritten->next = blockPtr;
+    return block->data;
+}
+
+/**
+ * Rend visible du lecteur l'objet réservé par ObjectFIFO_claim. Ne fait rien si aucun objet n'est réservé.
+ * @param fifo  FIFO dans laquelle on a écrit
+ * @remark      Ne modifie que les champs de l'écrivain.
+ */
+inline void ObjectFIFO_publish(ObjectFIFO fifo) {
+    if(fifo->claimed != NO_BLOCK) {
+        fifo->write = ((ObjectFIFO_Elem*)(fifo->data + fifo->claimed))->next;
+        fifo->claimed = NO_BLOCK;
+        MEMORY_BARRIER();   // l'objet doit être écrit avant d'être compté
+        fifo->pushNb++;
     }
+}
 
-    fifo->objNb++;
-    fifo->lastWritten = block;
-    fifo->write = blockPtr + neededSize;
+/**
+ * Comme ObjectFIFO_publish, mais l'objet est d'abord réduit à size octets : la fin de la place réservée est rendue à la file.
+ * Permet de réserver la taille maximale d'un objet dont on ne connait la taille qu'une fois rempli (trame reçue, message décodé...), sans perdre de place.
+ * @param fifo  FIFO dans laquelle on a écrit
+ * @param size  taille finale de l'objet, au plus celle passée à ObjectFIFO_claim
+ * @remark      Ne modifie que les champs de l'écrivain.
+ */
+inline void ObjectFIFO_publishSize(ObjectFIFO fifo, const USIZE size) {
+    if(fifo->claimed != NO_BLOCK) {
+        ObjectFIFO_Elem* block = (ObjectFIFO_Elem*)(fifo->data + fifo->claimed);
+        USIZE reserved = block->next == 0 ? fifo->size : block->next;
+        USIZE end = fifo->claimed + ALIGN(sizeof(ObjectFIFO_Elem) + size);
+        if(end > reserved) {    // plus grand que réservé : on garde la réservation
+            end = reserved;
+        }
+        block->next = end == fifo->size ? 0 : end;
+        ObjectFIFO_publish(fifo);
+    }
+}
 
-    return block->data;
+/**
+ * Renvoie un pointeur vers le premier objet de la FIFO, sans libérer sa place. Le pointeur reste valide jusqu'à l'appel de ObjectFIFO_release, quoi que fasse l'écrivain.
+ * @param fifo  FIFO à lire
+ * @return      Objet lu, null si la file était vide
+ * @remark      Ne modifie que les champs du lecteur.
+ */
+inline void* ObjectFIFO_borrow(const ObjectFIFO fifo) {
+    ObjectFIFO_Elem* elem = ObjectFIFO_head(fifo);
+    return elem == null ? null : elem->data;
+}
+
+/**
+ * Retire le premier objet de la FIFO, et libère sa place pour l'écrivain. Ne fait rien si la file est vide.
+ * @param fifo  FIFO à lire
+ * @remark      Ne modifie que les champs du lecteur.
+ */
+inline void ObjectFIFO_release(ObjectFIFO fifo) {
+    ObjectFIFO_pop(fifo);
 }
 
+/**
+ * Traite puis retire au plus maxNb objets de la FIFO, dans l'ordre. Chaque objet est traité directement dans la file, et sa place n'est libérée qu'une fois le traitement terminé.
+ * Il s'agit de la façon la plus efficace de vider la file : si elle est partagée avec une interruption, une seule protection suffit pour tout le lot.
+ * @param fifo  FIFO à lire
+ * @param maxNb nombre maximal d'objets à traiter
+ * @param todo  fonction à appliquer : todo(1° objet), todo(2° objet)...
+ * @return      nombre d'objets traités
+ */
+USIZE ObjectFIFO_drain(ObjectFIFO fifo, const USIZE maxNb, void (*todo)(void*)) {
+    USIZE ret = 0;
+    void* obj;
+    while(ret < maxNb && (obj = ObjectFIFO_borrow(fifo)) != null) {
+        todo(obj);
+        ObjectFIFO_release(fifo);
+        ret++;
+    }
+    return ret;
+}
+
+/**
+ * Execute une fonction sur tous les objets de la FIFO, dans l'ordre, sans les retirer.
+ * @param fifo  FIFO à parcourir
+ * @param todo  fonction à appliquer : todo(1° objet), todo(2° objet)...
+ * @return      nombre d'objets parcourus
+ * @remark      Ne lit que les objets publiés au moment de l'appel. Côté lecteur, comme ObjectFIFO_borrow.
+ */
+USIZE ObjectFIFO_executeAll(const ObjectFIFO fifo, void (*todo)(void*)) {
+    const USIZE nb = ObjectFIFO_getObjectNb(fifo);
+    USIZE ptr = fifo->read;
+    USIZE i;
+    MEMORY_BARRIER();
+    for(i=0; i<nb; i++) {
+        ObjectFIFO_Elem* elem = (ObjectFIFO_Elem*)(fifo->data + ptr);
+        if(elem->next == WRAP_MARK) {
+            elem = (ObjectFIFO_Elem*)fifo->data;
+        }
+        todo(elem->data);
+        ptr = elem->next;
+    }
+    return nb;
+}
+
+/**
+ * Ajoute plusieurs objets de même taille dans la FIFO.
+ * @param fifo  FIFO dans laquelle écrire
+ * @param nb    nombre d'objets
+ * @param size  taille de chaque objet
+ * @param data  tableau des objets à ajouter (nb*size octets)
+ * @return      nombre d'objets ajoutés. S'il est inférieur à nb, la FIFO était pleine : les objets suivants n'ont pas été ajoutés.
+ */
+USIZE ObjectFIFO_pushArray(ObjectFIFO fifo, const USIZE nb, const USIZE size, const void* data) {
+    const U8* obj = (const U8*) data;
+    USIZE ret;
+    for(ret=0; ret<nb; ret++) {
+        if(ObjectFIFO_push(fifo, size, obj) == null) {
+            break;
+        }
+        obj += size;
+    }
+    return ret;
+}
+
+
 
 
 
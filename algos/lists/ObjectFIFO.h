@@ -1,36 +1,52 @@
+#ifndef OBJECTFIFO_H
+#define OBJECTFIFO_H
 
 struct ObjectFIFO_Elem_struct {
-	U16 next;
-	U8 __attribute__((aligned(2))) data[];
+	USIZE next;                             /// lieu du bloc suivant, ou ~0 si ce n'est qu'une marque indiquant que le bloc suivant est au début du tableau
+	U8 __attribute__((aligned(sizeof(USIZE)))) data[];
 };
 typedef struct ObjectFIFO_Elem_struct ObjectFIFO_Elem;
 
 struct ObjectFIFO_struct{
-	U16 size;                               /// taille de la file
-	U16 write;                              /// lieu ou on écrira le prochain bloc
-	ObjectFIFO_Elem* lastWritten;           /// lieu du dernier bloc écrit
-	U16 read;                               /// lieu du prochain block à lire
-	U16 objNb;                              /// nombre de blocs stockés
-	U8 __attribute__((aligned(2))) data[];  /// tableau servant à stocker les données
+	USIZE size;                             /// taille de la file
+	USIZE write;                            /// (écrivain) lieu ou on écrira le prochain bloc
+	USIZE claimed;                          /// (écrivain) lieu du bloc réservé par ObjectFIFO_claim mais pas encore publié, ~0 s'il n'y en a pas
+	USIZE read;                             /// (lecteur) lieu du prochain block à lire
+	volatile USIZE pushNb;                  /// (écrivain) nombre de blocs publiés, modulo la taille de USIZE
+	volatile USIZE popNb;                   /// (lecteur) nombre de blocs libérés, modulo la taille de USIZE
+	U32 dropped;                            /// nombre d'objets écrasés par les fonctions *Overwrite
+	U8 __attribute__((aligned(sizeof(USIZE)))) data[]; /// tableau servant à stocker les données
 };
 typedef struct ObjectFIFO_struct* ObjectFIFO;
 
 
 
-inline ObjectFIFO ObjectFIFO_new(const U16 size);
+inline ObjectFIFO ObjectFIFO_new(const USIZE size);
 inline U8 ObjectFIFO_isEmpty(const ObjectFIFO fifo);
 inline U8 ObjectFIFO_isFull(const ObjectFIFO fifo);
-inline U16 ObjectFIFO_getAvailableSize(const ObjectFIFO fifo);
-inline U16 ObjectFIFO_getAllocatedSize(const ObjectFIFO fifo);
-inline U16 ObjectFIFO_getObjectNb(const ObjectFIFO fifo);
+inline USIZE ObjectFIFO_getAvailableSize(const ObjectFIFO fifo);
+inline USIZE ObjectFIFO_getAllocatedSize(const ObjectFIFO fifo);
+inline USIZE ObjectFIFO_getObjectNb(const ObjectFIFO fifo);
 inline void ObjectFIFO_clear(ObjectFIFO fifo);
 inline void ObjectFIFO_free(ObjectFIFO fifo);
 inline void* ObjectFIFO_get(const ObjectFIFO fifo);
 inline void* ObjectFIFO_pop(ObjectFIFO fifo);
-inline void* ObjectFIFO_push(ObjectFIFO fifo, const U16 size, const void* data);
-void* ObjectFIFO_allocate(ObjectFIFO fifo, const U16 size);
-
-
+inline void* ObjectFIFO_push(ObjectFIFO fifo, const USIZE size, const void* data);
+void* ObjectFIFO_allocate(ObjectFIFO fifo, const USIZE size);
+inline void* ObjectFIFO_pushOverwrite(ObjectFIFO fifo, const USIZE size, const void* data);
+void* ObjectFIFO_allocateOverwrite(ObjectFIFO fifo, const USIZE size);
+inline U32 ObjectFIFO_getDroppedNb(const ObjectFIFO fifo);
+inline void ObjectFIFO_resetDroppedNb(ObjectFIFO fifo);
+void* ObjectFIFO_claim(ObjectFIFO fifo, const USIZE size);
+inline void ObjectFIFO_publish(ObjectFIFO fifo);
+inline void ObjectFIFO_publishSize(ObjectFIFO fifo, const USIZE size);
+inline void* ObjectFIFO_borrow(const ObjectFIFO fifo);
+inline void ObjectFIFO_release(ObjectFIFO fifo);
+USIZE ObjectFIFO_drain(ObjectFIFO fifo, const USIZE maxNb, void (*todo)(void*));
+USIZE ObjectFIFO_executeAll(const ObjectFIFO fifo, void (*todo)(void*));
+USIZE ObjectFIFO_pushArray(ObjectFIFO fifo, const USIZE nb, const USIZE size, const void* data);
+
+#endif // OBJECTFIFO_H
 
 
 
@@ -8,28 +8,35 @@
  * Par pile, on entend une liste LIFO (last in first out).
  * Le système ne prévois pas en lui-même une protection contre les interruptions. La meilleure méthode est a priori de protéger toutes les fonctions d'ajout ou de lecture de données.
  * L'utilisateur doit être capable de connaitre la taille de ses données. La LIFO ne prévoit pas de moyen de la calculer (bien que ce soit en théorie possible)
+ *
+ * La LIFO peut aussi servir de zone de travail ("scratch arena") : ObjectLIFO_mark sauvegarde son état, ObjectLIFO_rewind y revient en libérant en une fois tout ce qui a été alloué depuis, quel que soit le nombre d'objets.
+ * Si OBJECTLIFO_POISON est défini (ex : -DOBJECTLIFO_POISON=0xA5), la mémoire libérée par ObjectLIFO_rewind est remplie avec cette valeur, pour repérer plus facilement les pointeurs utilisés après libération.
  */
 
-#include "Ogbwlib.h"
+#include "typedef.h"
 #include "ObjectLIFO.h"
 #include <stdlib.h>
 #include <string.h>
 
+#define ALIGNMENT	sizeof(void*)	// les blocs sont alignés sur un pointeur (un mot sur dsPIC), pour que leur champ prec le soit
+#define ALIGN(x)	(((x)+ALIGNMENT-1) & ~(USIZE)(ALIGNMENT-1))
+
 /**
  * Crée une nouvelle LIFO.
- * @param size  taille maximale des données à stoquer (en octets). Cette taille doit contenir aussi les données maintenant la liste (2 à 3 octets par objet)
+ * @param size  taille maximale des données à stoquer (en octets). Cette taille doit contenir aussi les données maintenant la liste (un pointeur par objet, plus l'alignement). Elle est arrondie au multiple de sizeof(void*) inférieur.
  * @return      un pointeur vers cette LIFO
  * @warning     Il s'agit en arrière plan d'un malloc, il faut donc libérer la mémoire avec ObjectLIFO_free.
  *
  * Le dimensionnement se fait ainsi : à tout instant, il faut vérifier
- *  size >= 3*(nb+1) + somme(j=1..nb, Sj)
+ *  size >= somme(j=1..nb, A(sizeof(ObjectLIFO_Elem) + Sj))
  *  où  nb est le nombre d'éléments de la file
  *      Sj est la taille du j-ième élément
+ *      A(x) est x arrondi au multiple de sizeof(void*) supérieur (2 sur dsPIC, 8 sur un PC 64 bits)
  */
-inline ObjectLIFO ObjectLIFO_new(const U16 size) {
+inline ObjectLIFO ObjectLIFO_new(const USIZE size) {
 	ObjectLIFO lifo = (ObjectLIFO) malloc(size+sizeof(struct ObjectLIFO_struct));
 	if(lifo != null) {
-		lifo->size = size;
+		lifo->size = size & ~(USIZE)(ALIGNMENT-1); // tous les blocs sont alignés, les octets en trop en fin de tableau seraient inutilisables
 		ObjectLIFO_clear(lifo);
 	}
 	return lifo;
@@ -57,9 +64,9 @@ inline U8 ObjectLIFO_isFull(const ObjectLIFO lifo) {
  * Détermine le nombre d'octets libres dans la LIFO
  * @param lifo  LIFO à tester
  * @return      Nombre d'octets libres
- * @warning     La taille renvoyée n'est pas totalement utilisable, il faut retirer 3 octets pour avoir la taille du plus gros objet stockable.
+ * @warning     La taille renvoyée n'est pas totalement utilisable, il faut retirer sizeof(ObjectLIFO_Elem) octets (et l'alignement) pour avoir la taille du plus gros objet stockable.
  */
-inline U16 ObjectLIFO_getAvailableSize(const ObjectLIFO lifo) {
+inline USIZE ObjectLIFO_getAvailableSize(const ObjectLIFO lifo) {
 	return lifo->size - lifo->allocatedSize;
 }
 
@@ -68,7 +75,7 @@ inline U16 ObjectLIFO_getAvailableSize(const ObjectLIFO lifo) {
  * @param lifo  LIFO à tester
  * @return      Nombre d'octets de données. Comprends la mémoire utilisée pour la gestion de la file.
  */
-inline U16 ObjectLIFO_getAllocatedSize(const ObjectLIFO lifo) {
+inline USIZE ObjectLIFO_getAllocatedSize(const ObjectLIFO lifo) {
 	return lifo->allocatedSize;
 }
 
@@ -77,10 +84,19 @@ inline U16 ObjectLIFO_getAllocatedSize(const ObjectLIFO lifo) {
  * @param lifo  LIFO à tester
  * @return      Nombre d'objets.
  */
-inline U16 ObjectLIFO_getObjectNb(const ObjectLIFO lifo) {
+inline USIZE ObjectLIFO_getObjectNb(const ObjectLIFO lifo) {
 	return lifo->objNb;
 }
 
+/**
+ * Détermine la taille maximale occupée dans la LIFO
+ * @param lifo  LIFO à tester
+ * @return      Nombre d'octets maximal alloué depuis la création de la LIFO ou le dernier clear (depuis la dernière marque si on est dans une frame, cf ObjectLIFO_mark)
+ */
+inline USIZE ObjectLIFO_getPeakSize(const ObjectLIFO lifo) {
+	return lifo->peak;
+}
+
 /**
  * Vide la LIFO
  * @param lifo      LIFO à vider
@@ -90,6 +106,7 @@ inline void ObjectLIFO_clear(ObjectLIFO lifo) {
 	lifo->allocatedSize = 0;
 	lifo->current = null;
 	lifo->objNb = 0;
+	lifo->peak = 0;
 }
 
 /**
@@ -138,15 +155,18 @@ inline void* ObjectLIFO_pop(ObjectLIFO lifo) {
  * @param data	Object a àjouter
  * @return      Pointeur vers la copie de l'objet dans la LIFO. null s'il n'y avait pas assez de place
  */
-inline void* ObjectLIFO_push(ObjectLIFO lifo, const U16 size, const void* data) {
-	if(ObjectLIFO_getAvailableSize(lifo) < size + sizeof(ObjectLIFO_Elem)) {
+inline void* ObjectLIFO_push(ObjectLIFO lifo, const USIZE size, const void* data) {
+	if(size > ObjectLIFO_getAvailableSize(lifo) || ObjectLIFO_getAvailableSize(lifo) < ALIGN(size + sizeof(ObjectLIFO_Elem))) { // la taille alignée est comparée, pour ne jamais dépasser size
 		return null;
 	}
 	ObjectLIFO_Elem* new = (ObjectLIFO_Elem*) (lifo->data + lifo->allocatedSize);
 	new->prec = lifo->current;
 	lifo-> current = new;
-	lifo->allocatedSize += size + sizeof(ObjectLIFO_Elem);
-	lifo->allocatedSize += lifo->allocatedSize&1?1:0; // always align on word
+	lifo->objNb++;
+	lifo->allocatedSize += ALIGN(size + sizeof(ObjectLIFO_Elem)); // always align on a pointer (a word on dsPIC)
+	if(lifo->allocatedSize > lifo->peak) {
+		lifo->peak = lifo->allocatedSize;
+	}
 	
 	memcpy(new->data, data, size);
 	return new->data;
@@ -158,19 +178,59 @@ inline void* ObjectLIFO_push(ObjectLIFO lifo, const U16 size, const void* data)
  * @param size  Taille de la méméoire à réserver
  * @return      Pointeur vers la mémoire allouée dans la LIFO. null s'il n'y avait pas assez de place
  */
-inline void* ObjectLIFO_alloc(ObjectLIFO lifo, const U16 size) {
-	if(ObjectLIFO_getAvailableSize(lifo) < size + sizeof(ObjectLIFO_Elem)) {
+inline void* ObjectLIFO_alloc(ObjectLIFO lifo, const USIZE size) {
+	if(size > ObjectLIFO_getAvailableSize(lifo) || ObjectLIFO_getAvailableSize(lifo) < ALIGN(size + sizeof(ObjectLIFO_Elem))) { // la taille alignée est comparée, pour ne jamais dépasser size
 		return null;
 	}
 	ObjectLIFO_Elem* new = (ObjectLIFO_Elem*) (lifo->data + lifo->allocatedSize);
 	new->prec = lifo->current;
 	lifo-> current = new;
-	lifo->allocatedSize += size + sizeof(ObjectLIFO_Elem);
-	lifo->allocatedSize += lifo->allocatedSize&1?1:0; // always align on word
+	lifo->objNb++;
+	lifo->allocatedSize += ALIGN(size + sizeof(ObjectLIFO_Elem)); // always align on a pointer (a word on dsPIC)
+	if(lifo->allocatedSize > lifo->peak) {
+		lifo->peak = lifo->allocatedSize;
+	}
 	
 	return new->data;
 }
 
+/**
+ * Sauvegarde l'état de la LIFO, pour pouvoir libérer plus tard en une fois tout ce qui sera alloué d'ici là (cf ObjectLIFO_rewind). Les marques peuvent être imbriquées.
+ * @param lifo  LIFO à marquer
+ * @return      la marque, à passer à ObjectLIFO_rewind
+ */
+inline ObjectLIFO_Mark ObjectLIFO_mark(ObjectLIFO lifo) {
+	ObjectLIFO_Mark mark;
+	mark.allocatedSize = lifo->allocatedSize;
+	mark.objNb = lifo->objNb;
+	mark.current = lifo->current;
+	mark.peak = lifo->peak;
+	lifo->peak = lifo->allocatedSize;
+	return mark;
+}
+
+/**
+ * Revient à l'état sauvegardé par ObjectLIFO_mark : tous les objets ajoutés depuis sont retirés, en temps constant.
+ * @param lifo  LIFO à ramener à la marque
+ * @param mark  marque obtenue par ObjectLIFO_mark sur cette LIFO
+ * @return      Nombre d'octets maximal occupé dans la LIFO depuis la marque (en plus de ce qui l'était déjà), pour dimensionner la LIFO.
+ * @warning     Les marques posées après celle-ci ne sont plus valides. Les pointeurs vers les objets retirés non plus.
+ */
+inline USIZE ObjectLIFO_rewind(ObjectLIFO lifo, const ObjectLIFO_Mark mark) {
+	USIZE framePeak = lifo->peak - mark.allocatedSize;
+#ifdef OBJECTLIFO_POISON
+	memset(lifo->data + mark.allocatedSize, OBJECTLIFO_POISON, lifo->allocatedSize - mark.allocatedSize);
+#endif
+	lifo->allocatedSize = mark.allocatedSize;
+	lifo->objNb = mark.objNb;
+	lifo->current = mark.current;
+	if(mark.peak > lifo->peak) {
+		lifo->peak = mark.peak;
+	}
+	return framePeak;
+}
+
+
 
 
 
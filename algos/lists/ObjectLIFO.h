@@ -1,28 +1,57 @@
 ﻿struct ObjectLIFO_Elem_struct {
 	struct ObjectLIFO_Elem_struct* prec;
-	U8 __attribute__((aligned(2))) data[];
+	U8 __attribute__((aligned(sizeof(void*)))) data[];
 };
 typedef struct ObjectLIFO_Elem_struct ObjectLIFO_Elem;
 
 struct ObjectLIFO_struct {
-	U16 size;
-	U16 allocatedSize;
-	U16 objNb;
+	USIZE size;
+	USIZE allocatedSize;
+	USIZE objNb;
 	ObjectLIFO_Elem* current;
-	U8 __attribute__((aligned(2))) data[];
+	USIZE peak;		/// taille allouée maximale depuis la création, le dernier clear ou la dernière marque
+	U8 __attribute__((aligned(sizeof(void*)))) data[];
 };
 typedef struct ObjectLIFO_struct* ObjectLIFO;
 
-inline ObjectLIFO ObjectLIFO_new(const U16 size);
+/**
+ * Etat de la LIFO sauvegardé par ObjectLIFO_mark, pour y revenir avec ObjectLIFO_rewind.
+ */
+typedef struct {
+	USIZE allocatedSize;
+	USIZE objNb;
+	ObjectLIFO_Elem* current;
+	USIZE peak;
+} ObjectLIFO_Mark;
+
+inline ObjectLIFO ObjectLIFO_new(const USIZE size);
 
 inline U8 ObjectLIFO_isEmpty(const ObjectLIFO lifo);
 inline U8 ObjectLIFO_isFull(const ObjectLIFO lifo);
-inline U16 ObjectLIFO_getAvailableSize(const ObjectLIFO lifo);
-inline U16 ObjectLIFO_getObjectNb(const ObjectLIFO lifo);
+inline USIZE ObjectLIFO_getAvailableSize(const ObjectLIFO lifo);
+inline USIZE ObjectLIFO_getAllocatedSize(const ObjectLIFO lifo);
+inline USIZE ObjectLIFO_getObjectNb(const ObjectLIFO lifo);
+inline USIZE ObjectLIFO_getPeakSize(const ObjectLIFO lifo);
 
 inline void ObjectLIFO_clear(ObjectLIFO lifo);
 inline void ObjectLIFO_free(ObjectLIFO lifo);
 
 inline void* ObjectLIFO_get(const ObjectLIFO lifo);
 inline void* ObjectLIFO_pop(ObjectLIFO lifo);
-inline void* ObjectLIFO_push(ObjectLIFO lifo, const U16 size, const void* data);
+inline void* ObjectLIFO_push(ObjectLIFO lifo, const USIZE size, const void* data);
+inline void* ObjectLIFO_alloc(ObjectLIFO lifo, const USIZE size);
+
+inline ObjectLIFO_Mark ObjectLIFO_mark(ObjectLIFO lifo);
+inline USIZE ObjectLIFO_rewind(ObjectLIFO lifo, const ObjectLIFO_Mark mark);
+
+/**
+ * Exécute un bout de code dans une "frame" de la LIFO : tout ce qui est alloué dans la LIFO pendant l'exécution du code est libéré d'un coup à la fin.
+ * Utile pour prendre des variables temporaires volumineuses dans une LIFO partagée plutôt que sur la pile.
+ * @param lifo  LIFO servant de zone de travail
+ * @param code  le bout de code à exécuter
+ * @warning     Ne pas sortir du code par un return, un break ou un goto : la mémoire ne serait pas libérée.
+ */
+#define OBJECTLIFO_FRAME(lifo,code) {                               \
+        ObjectLIFO_Mark __frame__ = ObjectLIFO_mark(lifo);          \
+        code                                                        \
+        ObjectLIFO_rewind(lifo, __frame__); }
@@ -0,0 +1,195 @@
+/** @file       PriorityQueue.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  PriorityQueue is a container that always gives back its smallest element first, according to the same isSmaller(a,b) order function as LinkedList_addSorted.
+ *  It is implemented by a binary heap stored in a fixed size array of pointers: push and popMin are in O(log(n)) instead of the O(n) of LinkedList_addSorted + LinkedList_removeFirst, and there is no allocation once the queue is created.
+ *  Just like LinkedList, the queue works with pointers and never copies the data. Elements that are equal are not garantied to come out in the order they were pushed.
+ *  The implementation offers no garanties against interrupt. If you need to use it on different IPL, protect every call to this library.
+*/
+
+#include <stdlib.h>
+#include "typedef.h"
+#include "PriorityQueue.h"
+
+static void siftUp(PriorityQueue queue, USIZE i) {
+    void* data = queue->data[i];
+    while(i > 0) {
+        USIZE parent = (i-1)/2;
+        if(!queue->isSmaller(data, queue->data[parent])) {
+            break;
+        }
+        queue->data[i] = queue->data[parent];
+        i = parent;
+    }
+    queue->data[i] = data;
+}
+
+static void siftDown(PriorityQueue queue, USIZE i) {
+    void* data = queue->data[i];
+    USIZE half = queue->size/2;       // elements from half have no child
+    while(i < half) {
+        USIZE child = 2*i+1;
+        if(child+1 < queue->size && queue->isSmaller(queue->data[child+1], queue->data[child])) {
+            child++;
+        }
+        if(!queue->isSmaller(queue->data[child], data)) {
+            break;
+        }
+        queue->data[i] = queue->data[child];
+        i = child;
+    }
+    queue->data[i] = data;
+}
+
+static USIZE find(const PriorityQueue queue, void* data) {   // returns size if not found
+    USIZE i;
+    for(i = 0; i < queue->size && queue->data[i] != data; i++);
+    return i;
+}
+
+/**
+ * Creates a new queue.
+ * @param capacity  max number of elements in the queue
+ * @param isSmaller order function. isSmaller(a,b) must return true iff a<b.
+ * @return          the queue created, null if there was not enought memory
+ * @warning         Memory is allocated with a malloc: 8 + 2*capacity bytes on the target. Use PriorityQueue_init instead if you want a static queue.
+ */
+PriorityQueue PriorityQueue_new(const USIZE capacity, U8 (*isSmaller)(void*, void*)) {
+    PriorityQueue ret = malloc(sizeof(struct PriorityQueue_struct) + (U32)capacity * sizeof(void*));
+    if (ret != null) {
+        PriorityQueue_init(ret, (void**)(ret + 1), capacity, isSmaller);
+    }
+    return ret;
+}
+
+/**
+ * Initialise a queue that was not created by PriorityQueue_new, on a buffer provided by the caller.
+ * @param buffer    array of capacity pointers, which must live as long as the queue
+ * @param capacity  max number of elements in the queue
+ * @param isSmaller order function. isSmaller(a,b) must return true iff a<b.
+ */
+inline void PriorityQueue_init(PriorityQueue queue, void** buffer, const USIZE capacity, U8 (*isSmaller)(void*, void*)) {
+    queue->capacity = capacity;
+    queue->size = 0;
+    queue->isSmaller = isSmaller;
+    queue->data = buffer;
+}
+
+/**
+ * @return true iff the queue contains no element
+ */
+inline U8 PriorityQueue_isEmpty(const PriorityQueue queue) {
+    return queue->size == 0;
+}
+
+/**
+ * @return true iff no element can be pushed anymore
+ */
+inline U8 PriorityQueue_isFull(const PriorityQueue queue) {
+    return queue->size == queue->capacity;
+}
+
+/**
+ * @return number of elements in the queue
+ */
+inline USIZE PriorityQueue_getSize(const PriorityQueue queue) {
+    return queue->size;
+}
+
+/**
+ * @return max number of elements in the queue
+ */
+inline USIZE PriorityQueue_getCapacity(const PriorityQueue queue) {
+    return queue->capacity;
+}
+
+/**
+ * Remove all the elements. The data are not freed.
+ */
+inline void PriorityQueue_clear(PriorityQueue queue) {
+    queue->size = 0;
+}
+
+/**
+ * Unallocate a queue created by PriorityQueue_new. The data are not freed.
+ */
+inline void PriorityQueue_free(PriorityQueue queue) {
+    free(queue);
+}
+
+/**
+ * Read the smallest element without removing it, in O(1).
+ * @return  the smallest element, null if the queue is empty
+ */
+inline void* PriorityQueue_peek(const PriorityQueue queue) {
+    return queue->size == 0 ? null : queue->data[0];
+}
+
+/**
+ * Add an element, in O(log(n)).
+ * @param data  ptr to the element
+ * @return      PriorityQueue_FULL or PriorityQueue_OK
+ */
+PriorityQueue_Error PriorityQueue_push(PriorityQueue queue, void* data) {
+    if(queue->size == queue->capacity) {
+        return PriorityQueue_FULL;
+    }
+    queue->data[queue->size] = data;
+    siftUp(queue, queue->size++);
+    return PriorityQueue_OK;
+}
+
+/**
+ * Remove the smallest element, in O(log(n)).
+ * @return  the element removed, null if the queue is empty
+ */
+void* PriorityQueue_popMin(PriorityQueue queue) {
+    if(queue->size == 0) {
+        return null;
+    }
+    void* ret = queue->data[0];
+    queue->size--;
+    if(queue->size > 0) {
+        queue->data[0] = queue->data[queue->size];
+        siftDown(queue, 0);
+    }
+    return ret;
+}
+
+/**
+ * Restore the order of the queue after the key of an element has been decreased (e.g. an event brought forward).
+ * Finding the element is in O(n), restoring the order in O(log(n)).
+ * @param data  ptr to the element, already modified
+ * @return      PriorityQueue_NOT_FOUND or PriorityQueue_OK
+ * @warning     If the key was increased, use PriorityQueue_removePtr then PriorityQueue_push instead.
+ */
+PriorityQueue_Error PriorityQueue_decreaseKey(PriorityQueue queue, void* data) {
+    USIZE i = find(queue, data);
+    if(i == queue->size) {
+        return PriorityQueue_NOT_FOUND;
+    }
+    siftUp(queue, i);
+    return PriorityQueue_OK;
+}
+
+/**
+ * Remove an element which is not necessarily the smallest one (e.g. a cancelled event).
+ * Finding the element is in O(n), restoring the order in O(log(n)).
+ * @param data  ptr to the element
+ * @return      PriorityQueue_NOT_FOUND or PriorityQueue_OK
+ */
+PriorityQueue_Error PriorityQueue_removePtr(PriorityQueue queue, void* data) {
+    USIZE i = find(queue, data);
+    if(i == queue->size) {
+        return PriorityQueue_NOT_FOUND;
+    }
+    queue->size--;
+    if(i < queue->size) {
+        queue->data[i] = queue->data[queue->size];
+        siftDown(queue, i);
+        siftUp(queue, i);
+    }
+    return PriorityQueue_OK;
+}
@@ -0,0 +1,36 @@
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include "../../typedef.h"
+
+struct PriorityQueue_struct {
+    USIZE capacity;                       /// max number of elements
+    USIZE size;                           /// number of elements actually stored
+    U8 (*isSmaller)(void*, void*);      /// order function. isSmaller(a,b) returns true iff a<b
+    void** data;                        /// binary heap: the children of data[i] are data[2i+1] and data[2i+2]
+};
+typedef struct PriorityQueue_struct* PriorityQueue;
+
+typedef enum {
+    PriorityQueue_OK = 0,
+    PriorityQueue_FULL = 1,
+    PriorityQueue_NOT_FOUND = 2
+} PriorityQueue_Error;
+
+PriorityQueue PriorityQueue_new(const USIZE capacity, U8 (*isSmaller)(void*, void*));
+inline void PriorityQueue_init(PriorityQueue queue, void** buffer, const USIZE capacity, U8 (*isSmaller)(void*, void*));
+
+inline U8 PriorityQueue_isEmpty(const PriorityQueue queue);
+inline U8 PriorityQueue_isFull(const PriorityQueue queue);
+inline USIZE PriorityQueue_getSize(const PriorityQueue queue);
+inline USIZE PriorityQueue_getCapacity(const PriorityQueue queue);
+inline void PriorityQueue_clear(PriorityQueue queue);
+inline void PriorityQueue_free(PriorityQueue queue);
+
+inline void* PriorityQueue_peek(const PriorityQueue queue);
+PriorityQueue_Error PriorityQueue_push(PriorityQueue queue, void* data);
+void* PriorityQueue_popMin(PriorityQueue queue);
+PriorityQueue_Error PriorityQueue_decreaseKey(PriorityQueue queue, void* data);
+PriorityQueue_Error PriorityQueue_removePtr(PriorityQueue queue, void* data);
+
+#endif // PRIORITYQUEUE_H
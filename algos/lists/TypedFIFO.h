@@ -0,0 +1,201 @@
+/** @file       TypedFIFO.h
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  TypedFIFO generates FIFOs specialised for one element type (U16 ADC readings, Vector samples, structs...).
+ *  Compared to ObjectFIFO, there is no header nor padding per element, and elements are copied by assignment instead of memcpy through a void*.
+ *  Compared to ByteFIFO, you don't have to serialise the elements in bytes.
+ *
+ *  TYPEDFIFO_DECLARE(Name, Type) declares the type Name and its functions: put it in a header.
+ *  TYPEDFIFO_DEFINE(Name, Type) defines the functions: put it in exactly one .c file.
+ *
+ *  Example:
+ *      TYPEDFIFO_DECLARE(SampleFIFO, U16)     // in adc.h
+ *      TYPEDFIFO_DEFINE(SampleFIFO, U16)      // in adc.c
+ *
+ *      SampleFIFO samples = SampleFIFO_new(64);
+ *      SampleFIFO_push(samples, ADC1BUF0);
+ *      U16 s;
+ *      while(SampleFIFO_pop(samples, &s)) {...}
+ *
+ *  The generated functions are (with Name = X):
+ *      X X_new(USIZE size)                         allocate a FIFO of size elements with a malloc
+ *      void X_init(X fifo, Type* buffer, USIZE size)  initialise a FIFO (e.g. a static struct X_struct) on a buffer of size elements, aligned for Type
+ *      void X_free(X fifo)                         unallocate a FIFO created by X_new
+ *      void X_clear(X fifo)
+ *      U8 X_isEmpty(X fifo), U8 X_isFull(X fifo)
+ *      USIZE X_getNb(X fifo)                       number of elements stored
+ *      USIZE X_getAvailableNb(X fifo)              number of elements that can still be pushed
+ *      U8 X_push(X fifo, Type value)               false if the FIFO is full
+ *      U8 X_pushOverwrite(X fifo, Type value)      evicts the oldest element if the FIFO is full. Returns true if an element was evicted.
+ *      U8 X_pop(X fifo, Type* value)               false if the FIFO is empty
+ *      Type* X_peek(X fifo)                        ptr to the oldest element (still in the FIFO), null if the FIFO is empty
+ *      USIZE X_pushArray(X fifo, USIZE nb, const Type* values)  push as many elements as possible, returns the number pushed
+ *      USIZE X_popArray(X fifo, USIZE maxNb, Type* values)      pop up to maxNb elements, returns the number popped
+ *
+ *  The implementation offers no garanties against interrupt. If you need to use it on different IPL, protect every call to the generated functions.
+*/
+
+#ifndef TYPEDFIFO_H
+#define TYPEDFIFO_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "../../typedef.h"
+
+#define TYPEDFIFO_DECLARE(Name, Type)                                           \
+struct Name##_struct {                                                          \
+    USIZE size;     /* FIFO size (max number of elements) */                    \
+    USIZE readPtr;  /* index of next element to read */                         \
+    USIZE writePtr; /* index of next element to write */                        \
+    USIZE dataNb;   /* number of elements actually stored */                    \
+    Type* data;     /* data container */                                        \
+};                                                                              \
+typedef struct Name##_struct* Name;                                             \
+                                                                                \
+Name Name##_new(const USIZE size);                                              \
+void Name##_init(Name fifo, Type* buffer, const USIZE size);                    \
+void Name##_free(Name fifo);                                                    \
+void Name##_clear(Name fifo);                                                   \
+U8 Name##_isEmpty(const Name fifo);                                             \
+U8 Name##_isFull(const Name fifo);                                              \
+USIZE Name##_getNb(const Name fifo);                                            \
+USIZE Name##_getAvailableNb(const Name fifo);                                   \
+U8 Name##_push(Name fifo, const Type value);                                    \
+U8 Name##_pushOverwrite(Name fifo, const Type value);                           \
+U8 Name##_pop(Name fifo, Type* value);                                          \
+Type* Name##_peek(const Name fifo);                                             \
+USIZE Name##_pushArray(Name fifo, const USIZE nb, const Type* values);          \
+USIZE Name##_popArray(Name fifo, const USIZE maxNb, Type* values);
+
+/// offset of the elements in a FIFO allocated by Name##_new: the struct, padded to the alignment of Type (e.g. long double on a 64 bits PC)
+#define TYPEDFIFO_DATA_OFFSET(Name, Type)   ((sizeof(struct Name##_struct) + __alignof__(Type) - 1) / __alignof__(Type) * __alignof__(Type))
+
+#define TYPEDFIFO_DEFINE(Name, Type)                                            \
+Name Name##_new(const USIZE size) {                                             \
+    const size_t offset = TYPEDFIFO_DATA_OFFSET(Name, Type);                    \
+    Name ret = malloc(offset + (U32)size * sizeof(Type));                       \
+    if(ret != null) {                                                           \
+        Name##_init(ret, (Type*)((U8*)ret + offset), size);                     \
+    }                                                                           \
+    return ret;                                                                 \
+}                                                                               \
+                                                                                \
+void Name##_init(Name fifo, Type* buffer, const USIZE size) {                   \
+    fifo->size = size;                                                          \
+    fifo->data = buffer;                                                        \
+    Name##_clear(fifo);                                                         \
+}                                                                               \
+                                                                                \
+void Name##_free(Name fifo) {                                                   \
+    free(fifo);                                                                 \
+}                                                                               \
+                                                                                \
+void Name##_clear(Name fifo) {                                                  \
+    fifo->readPtr = 0;                                                          \
+    fifo->writePtr = 0;                                                         \
+    fifo->dataNb = 0;                                                           \
+}                                                                               \
+                                                                                \
+U8 Name##_isEmpty(const Name fifo) {                                            \
+    return fifo->dataNb == 0;                                                   \
+}                                                                               \
+                                                                                \
+U8 Name##_isFull(const Name fifo) {                                             \
+    return fifo->dataNb == fifo->size;                                          \
+}                                                                               \
+                                                                                \
+USIZE Name##_getNb(const Name fifo) {                                           \
+    return fifo->dataNb;                                                        \
+}                                                                               \
+                                                                                \
+USIZE Name##_getAvailableNb(const Name fifo) {                                  \
+    return fifo->size - fifo->dataNb;                                           \
+}                                                                               \
+                                                                                \
+U8 Name##_push(Name fifo, const Type value) {                                   \
+    if(fifo->dataNb == fifo->size) {                                            \
+        return 0;                                                               \
+    }                                                                           \
+    fifo->data[fifo->writePtr] = value;                                         \
+    if(++fifo->writePtr == fifo->size) {                                        \
+        fifo->writePtr = 0;                                                     \
+    }                                                                           \
+    fifo->dataNb++;                                                             \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+U8 Name##_pushOverwrite(Name fifo, const Type value) {                          \
+    U8 evicted = 0;                                                             \
+    if(fifo->size == 0) {                                                       \
+        return 0;                                                               \
+    }                                                                           \
+    if(fifo->dataNb == fifo->size) {                                            \
+        if(++fifo->readPtr == fifo->size) {                                     \
+            fifo->readPtr = 0;                                                  \
+        }                                                                       \
+        fifo->dataNb--;                                                         \
+        evicted = 1;                                                            \
+    }                                                                           \
+    Name##_push(fifo, value);                                                   \
+    return evicted;                                                             \
+}                                                                               \
+                                                                                \
+U8 Name##_pop(Name fifo, Type* value) {                                         \
+    if(fifo->dataNb == 0) {                                                     \
+        return 0;                                                               \
+    }                                                                           \
+    *value = fifo->data[fifo->readPtr];                                         \
+    if(++fifo->readPtr == fifo->size) {                                         \
+        fifo->readPtr = 0;                                                      \
+    }                                                                           \
+    fifo->dataNb--;                                                             \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+Type* Name##_peek(const Name fifo) {                                            \
+    return fifo->dataNb == 0 ? null : &fifo->data[fifo->readPtr];               \
+}                                                                               \
+                                                                                \
+USIZE Name##_pushArray(Name fifo, const USIZE nb, const Type* values) {         \
+    USIZE n = fifo->size - fifo->dataNb;                                        \
+    USIZE first;                                                                \
+    if(n > nb) {                                                                \
+        n = nb;                                                                 \
+    }                                                                           \
+    first = fifo->size - fifo->writePtr;    /* room before the end */           \
+    if(first > n) {                                                             \
+        first = n;                                                              \
+    }                                                                           \
+    memcpy(&fifo->data[fifo->writePtr], values, first * sizeof(Type));          \
+    memcpy(fifo->data, values + first, (n - first) * sizeof(Type));             \
+    fifo->writePtr += n;                                                        \
+    if(fifo->writePtr >= fifo->size) {                                          \
+        fifo->writePtr -= fifo->size;                                           \
+    }                                                                           \
+    fifo->dataNb += n;                                                          \
+    return n;                                                                   \
+}                                                                               \
+                                                                                \
+USIZE Name##_popArray(Name fifo, const USIZE maxNb, Type* values) {             \
+    USIZE n = fifo->dataNb;                                                     \
+    USIZE first;                                                                \
+    if(n > maxNb) {                                                             \
+        n = maxNb;                                                              \
+    }                                                                           \
+    first = fifo->size - fifo->readPtr;     /* data before the end */           \
+    if(first > n) {                                                             \
+        first = n;                                                              \
+    }                                                                           \
+    memcpy(values, &fifo->data[fifo->readPtr], first * sizeof(Type));           \
+    memcpy(values + first, fifo->data, (n - first) * sizeof(Type));             \
+    fifo->readPtr += n;                                                         \
+    if(fifo->readPtr >= fifo->size) {                                           \
+        fifo->readPtr -= fifo->size;                                            \
+    }                                                                           \
+    fifo->dataNb -= n;                                                          \
+    return n;                                                                   \
+}
+
+#endif // TYPEDFIFO_H
@@ -0,0 +1,448 @@
+/** @file       UnrolledList.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  UnrolledList is a generic doubly linked list that stores up to UNROLLEDLIST_CHUNK_SIZE data pointers in each node (a "chunk").
+ *  It offers the same functions as LinkedList (and the same LinkedList_error codes), so switching from one to the other is mostly a matter of renaming.
+ *  Because the pointers are stored side by side, a traversal (executeAll, getFilter, removeIf...) reads one chunk for several elements, instead of one malloc block per element. This makes it much more cache friendly on a host, and divides the number of mallocs by up to UNROLLEDLIST_CHUNK_SIZE on the target.
+ *  Just like LinkedList, the list works with pointers and never copies the data.
+ *  The implementation offers no garanties against interrupt. If you need to use it on different IPL, protect every call to this library.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "typedef.h"
+#include "UnrolledList.h"
+
+static UnrolledList_chunk* newChunkAfter(UnrolledList list, UnrolledList_chunk* prev) { // prev == null to add the chunk at the head
+    UnrolledList_chunk* chunk = malloc(sizeof(UnrolledList_chunk));
+    if(chunk == null) {
+        return null;
+    }
+    chunk->nb = 0;
+    chunk->prev = prev;
+    chunk->next = (prev == null) ? list->first : prev->next;
+    if(chunk->next != null) {
+        chunk->next->prev = chunk;
+    } else {
+        list->last = chunk;
+    }
+    if(prev != null) {
+        prev->next = chunk;
+    } else {
+        list->first = chunk;
+    }
+    return chunk;
+}
+
+static void freeChunk(UnrolledList list, UnrolledList_chunk* chunk) {
+    if(chunk->prev != null) {
+        chunk->prev->next = chunk->next;
+    } else {
+        list->first = chunk->next;
+    }
+    if(chunk->next != null) {
+        chunk->next->prev = chunk->prev;
+    } else {
+        list->last = chunk->prev;
+    }
+    free(chunk);
+}
+
+static UnrolledList_chunk* findChunk(const UnrolledList list, USIZE* num) {    // suppose *num < list->size. *num becomes the index inside the chunk
+    UnrolledList_chunk* chunk;
+    if(*num < list->size/2) {   // start from the nearest end
+        chunk = list->first;
+        while(*num >= chunk->nb) {
+            *num -= chunk->nb;
+            chunk = chunk->next;
+        }
+    } else {
+        USIZE fromEnd = list->size - 1 - *num;
+        chunk = list->last;
+        while(fromEnd >= chunk->nb) {
+            fromEnd -= chunk->nb;
+            chunk = chunk->prev;
+        }
+        *num = chunk->nb - 1 - fromEnd;
+    }
+    return chunk;
+}
+
+static void* removeAt(UnrolledList list, UnrolledList_chunk* chunk, USIZE i) {
+    void* ret = chunk->data[i];
+    chunk->nb--;
+    list->size--;
+    if(chunk->nb == 0) {
+        freeChunk(list, chunk);
+    } else {
+        memmove(&chunk->data[i], &chunk->data[i+1], (chunk->nb - i) * sizeof(void*));
+    }
+    return ret;
+}
+
+static USIZE compact(UnrolledList list, U8 (*match)(void*), U8 freeData) {
+    // one pass: the elements kept are copied over the removed ones, then the chunks left empty at the end are freed
+    UnrolledList_chunk* src = list->first;
+    UnrolledList_chunk* dest = list->first;
+    USIZE destNb = 0;
+    USIZE ret = 0;
+    USIZE i;
+    for(; src != null; src = src->next) {
+        for(i = 0; i < src->nb; i++) {
+            void* data = src->data[i];
+            if(match(data)) {
+                if(freeData) {
+                    free(data);
+                }
+                ret++;
+            } else {
+                if(destNb == UNROLLEDLIST_CHUNK_SIZE) { // never overtakes src, since at most as many elements are written as read
+                    dest->nb = destNb;
+                    dest = dest->next;
+                    destNb = 0;
+                }
+                dest->data[destNb++] = data;
+            }
+        }
+    }
+    // even if nothing matched, the elements may have been packed in fewer chunks
+    list->size -= ret;
+    if(destNb == 0) {   // only possible if nothing was kept
+        dest = null;
+    } else {
+        dest->nb = destNb;
+    }
+    while(list->last != dest) {
+        freeChunk(list, list->last);
+    }
+    return ret;
+}
+
+static USIZE clear(UnrolledList list, U8 freeData) {
+    UnrolledList_chunk* chunk = list->first;
+    USIZE ret = list->size;
+    USIZE i;
+    while(chunk != null) {
+        UnrolledList_chunk* next = chunk->next;
+        if(freeData) {
+            for(i = 0; i < chunk->nb; i++) {
+                free(chunk->data[i]);
+            }
+        }
+        free(chunk);
+        chunk = next;
+    }
+    list->first = null;
+    list->last = null;
+    list->size = 0;
+    return ret;
+}
+
+/**
+ * Creates an empty list.
+ * @return  the list created, null if there was not enought memory
+ */
+UnrolledList UnrolledList_new() {
+    UnrolledList ret = malloc(sizeof(*ret));
+    if(ret != null) {
+        ret->first = null;
+        ret->last = null;
+        ret->size = 0;
+    }
+    return ret;
+}
+
+/**
+ * Unallocate the list and its chunks. The data are not freed (see UnrolledList_deleteAll).
+ */
+void UnrolledList_free(UnrolledList list) {
+    clear(list, 0);
+    free(list);
+}
+
+/**
+ * @return  number of elements of the list, in O(1)
+ */
+inline USIZE UnrolledList_size(const UnrolledList list) {
+    return list->size;
+}
+
+/**
+ * @return  true iff the list is empty
+ */
+inline U8 UnrolledList_isEmpty(const UnrolledList list) {
+    return list->size == 0;
+}
+
+/**
+ * Add an element at the head of the list.
+ * @param data  ptr to the element to add
+ * @return      LINKEDLIST_OUT_OF_MEMORY or LINKEDLIST_SUCCESS
+ */
+LinkedList_error UnrolledList_addFirst(UnrolledList list, void* data) {
+    UnrolledList_chunk* chunk = list->first;
+    if(chunk == null || chunk->nb == UNROLLEDLIST_CHUNK_SIZE) {
+        chunk = newChunkAfter(list, null);
+        if(chunk == null) {
+            return LINKEDLIST_OUT_OF_MEMORY;
+        }
+    }
+    memmove(&chunk->data[1], &chunk->data[0], chunk->nb * sizeof(void*));
+    chunk->data[0] = data;
+    chunk->nb++;
+    list->size++;
+    return LINKEDLIST_SUCCESS;
+}
+
+/**
+ * Add an element in the middle of the list. If its chunk is full, it is split in two halves.
+ * @param data  ptr to the element to add
+ * @param num   index of the element after insertion (starting at 0)
+ * @return      LINKEDLIST_OUT_OF_RANGE, LINKEDLIST_OUT_OF_MEMORY or LINKEDLIST_SUCCESS
+ */
+LinkedList_error UnrolledList_addMiddle(UnrolledList list, void* data, USIZE num) {
+    if(num > list->size) {
+        return LINKEDLIST_OUT_OF_RANGE;
+    }
+    if(num == list->size) {
+        return UnrolledList_addLast(list, data);
+    }
+    UnrolledList_chunk* chunk = findChunk(list, &num);
+    if(chunk->nb == UNROLLEDLIST_CHUNK_SIZE) {
+        UnrolledList_chunk* half = newChunkAfter(list, chunk);
+        if(half == null) {
+            return LINKEDLIST_OUT_OF_MEMORY;
+        }
+        half->nb = UNROLLEDLIST_CHUNK_SIZE / 2;
+        chunk->nb = UNROLLEDLIST_CHUNK_SIZE - half->nb;
+        memcpy(half->data, &chunk->data[chunk->nb], half->nb * sizeof(void*));
+        if(num > chunk->nb) {
+            num -= chunk->nb;
+            chunk = half;
+        }
+    }
+    memmove(&chunk->data[num+1], &chunk->data[num], (chunk->nb - num) * sizeof(void*));
+    chunk->data[num] = data;
+    chunk->nb++;
+    list->size++;
+    return LINKEDLIST_SUCCESS;
+}
+
+/**
+ * Add an element at the end of the list.
+ * @param data  ptr to the element to add
+ * @return      LINKEDLIST_OUT_OF_MEMORY or LINKEDLIST_SUCCESS
+ */
+LinkedList_error UnrolledList_addLast(UnrolledList list, void* data) {
+    UnrolledList_chunk* chunk = list->last;
+    if(chunk == null || chunk->nb == UNROLLEDLIST_CHUNK_SIZE) {
+        chunk = newChunkAfter(list, chunk);
+        if(chunk == null) {
+            return LINKEDLIST_OUT_OF_MEMORY;
+        }
+    }
+    chunk->data[chunk->nb++] = data;
+    list->size++;
+    return LINKEDLIST_SUCCESS;
+}
+
+/**
+ * @return  first element of the list, null if the list is empty
+ */
+void* UnrolledList_getFirst(const UnrolledList list) {
+    return list->first == null ? null : list->first->data[0];
+}
+
+/**
+ * @param num   index of the element (starting at 0)
+ * @return      the element, null if num is out of range
+ */
+void* UnrolledList_getMiddle(const UnrolledList list, USIZE num) {
+    if(num >= list->size) {
+        return null;
+    }
+    UnrolledList_chunk* chunk = findChunk(list, &num);
+    return chunk->data[num];
+}
+
+/**
+ * @return  last element of the list, null if the list is empty
+ */
+void* UnrolledList_getLast(const UnrolledList list) {
+    return list->last == null ? null : list->last->data[list->last->nb - 1];
+}
+
+/**
+ * Find the first element matching a filter. It is not removed from the list.
+ * @param match filter. match(element) must return true for the element to return.
+ * @return      the element found, null if none matches
+ */
+void* UnrolledList_getFilter(const UnrolledList list, U8 (*match)(void*)) {
+    UnrolledList_chunk* chunk;
+    USIZE i;
+    for(chunk = list->first; chunk != null; chunk = chunk->next) {
+        for(i = 0; i < chunk->nb; i++) {
+            if(match(chunk->data[i])) {
+                return chunk->data[i];
+            }
+        }
+    }
+    return null;
+}
+
+/**
+ * Remove the first element of the list.
+ * @return  the element removed, null if the list is empty
+ */
+void* UnrolledList_removeFirst(UnrolledList list) {
+    if(list->first == null) {
+        return null;
+    }
+    return removeAt(list, list->first, 0);
+}
+
+/**
+ * Remove an element in the middle of the list.
+ * @param num   index of the element (starting at 0)
+ * @return      the element removed, null if num is out of range
+ */
+void* UnrolledList_removeMiddle(UnrolledList list, USIZE num) {
+    if(num >= list->size) {
+        return null;
+    }
+    UnrolledList_chunk* chunk = findChunk(list, &num);
+    return removeAt(list, chunk, num);
+}
+
+/**
+ * Remove the last element of the list.
+ * @return  the element removed, null if the list is empty
+ */
+void* UnrolledList_removeLast(UnrolledList list) {
+    if(list->last == null) {
+        return null;
+    }
+    return removeAt(list, list->last, list->last->nb - 1);
+}
+
+/**
+ * Remove the first occurence of a pointer.
+ * @param data  pointer to find in the list
+ * @return      the pointer, null if it was not in the list
+ */
+void* UnrolledList_removePtr(UnrolledList list, void* data) {
+    UnrolledList_chunk* chunk;
+    USIZE i;
+    for(chunk = list->first; chunk != null; chunk = chunk->next) {
+        for(i = 0; i < chunk->nb; i++) {
+            if(chunk->data[i] == data) {
+                return removeAt(list, chunk, i);
+            }
+        }
+    }
+    return null;
+}
+
+/**
+ * Remove the first element matching a filter.
+ * @param match filter. match(element) must return true for the element to remove.
+ * @return      the element removed, null if none matches
+ */
+void* UnrolledList_removeFilter(UnrolledList list, U8 (*match)(void*)) {
+    UnrolledList_chunk* chunk;
+    USIZE i;
+    for(chunk = list->first; chunk != null; chunk = chunk->next) {
+        for(i = 0; i < chunk->nb; i++) {
+            if(match(chunk->data[i])) {
+                return removeAt(list, chunk, i);
+            }
+        }
+    }
+    return null;
+}
+
+/**
+ * Remove all the elements of the list. The data are not freed.
+ * @return  number of elements removed
+ */
+USIZE UnrolledList_removeAll(UnrolledList list) {
+    return clear(list, 0);
+}
+
+/**
+ * Remove all the elements matching a filter, in one pass. The elements kept are packed in the first chunks, and the chunks left empty are freed.
+ * @param match filter. match(element) must return true for the elements to remove.
+ * @return      number of elements removed
+ */
+USIZE UnrolledList_removeIf(UnrolledList list, U8 (*match)(void*)) {
+    return compact(list, match, 0);
+}
+
+/**
+ * Remove all the elements of the list, and apply free to each of them.
+ * @return  number of elements deleted
+ * @warning If an element is in the list twice, it will be freed twice.
+ */
+USIZE UnrolledList_deleteAll(UnrolledList list) {
+    return clear(list, 1);
+}
+
+/**
+ * Remove all the elements matching a filter, and apply free to each of them.
+ * @param match filter. match(element) must return true for the elements to delete.
+ * @return      number of elements deleted
+ */
+USIZE UnrolledList_deleteIf(UnrolledList list, U8 (*match)(void*)) {
+    return compact(list, match, 1);
+}
+
+/**
+ * Execute a function on every element, from the first to the last.
+ * @param todo  function to execute. It must not modify the list.
+ */
+void UnrolledList_executeAll(const UnrolledList list, void (*todo)(void*)) {
+    UnrolledList_chunk* chunk;
+    USIZE i;
+    for(chunk = list->first; chunk != null; chunk = chunk->next) {
+        for(i = 0; i < chunk->nb; i++) {
+            todo(chunk->data[i]);
+        }
+    }
+}
+
+/**
+ * Execute a function on every element, from the last to the first.
+ * @param todo  function to execute. It must not modify the list.
+ */
+void UnrolledList_reverseExecuteAll(const UnrolledList list, void (*todo)(void*)) {
+    UnrolledList_chunk* chunk;
+    USIZE i;
+    for(chunk = list->last; chunk != null; chunk = chunk->prev) {
+        for(i = chunk->nb; i > 0; i--) {
+            todo(chunk->data[i-1]);
+        }
+    }
+}
+
+/**
+ * Execute a function on every element matching a filter.
+ * @param match filter. match(element) returns true iff todo(element) must be executed.
+ * @param todo  function to execute. It must not modify the list.
+ * @return      number of elements on which todo has been executed
+ */
+USIZE UnrolledList_executeIf(const UnrolledList list, U8 (*match)(void*), void (*todo)(void*)) {
+    UnrolledList_chunk* chunk;
+    USIZE ret = 0;
+    USIZE i;
+    for(chunk = list->first; chunk != null; chunk = chunk->next) {
+        for(i = 0; i < chunk->nb; i++) {
+            if(match(chunk->data[i])) {
+                todo(chunk->data[i]);
+                ret++;
+            }
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,59 @@
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include "../../typedef.h"
+#include "LinkedList.h"
+
+/**
+ * Number of data pointers stored in each chunk.
+ * Bigger chunks mean less mallocs and less pointer chasing, but more memory wasted in the partially filled chunks and longer shifts when inserting in the middle.
+ */
+#ifndef UNROLLEDLIST_CHUNK_SIZE
+#define UNROLLEDLIST_CHUNK_SIZE 8
+#endif
+
+typedef struct UnrolledList_chunk_ {
+    struct UnrolledList_chunk_* next;
+    struct UnrolledList_chunk_* prev;
+    USIZE nb;                               /// number of data pointers used in this chunk (never 0)
+    void* data[UNROLLEDLIST_CHUNK_SIZE];
+} UnrolledList_chunk;
+
+struct UnrolledList_struct {
+    UnrolledList_chunk* first;  /// first chunk (null if the list is empty)
+    UnrolledList_chunk* last;   /// last chunk (null if the list is empty)
+    USIZE size;                 /// number of elements
+};
+typedef struct UnrolledList_struct* UnrolledList;
+
+UnrolledList UnrolledList_new();
+void UnrolledList_free(UnrolledList list);
+
+inline USIZE UnrolledList_size(const UnrolledList list);
+inline U8 UnrolledList_isEmpty(const UnrolledList list);
+
+LinkedList_error UnrolledList_addFirst(UnrolledList list, void* data);
+LinkedList_error UnrolledList_addMiddle(UnrolledList list, void* data, USIZE num);
+LinkedList_error UnrolledList_addLast(UnrolledList list, void* data);
+
+void* UnrolledList_getFirst(const UnrolledList list);
+void* UnrolledList_getMiddle(const UnrolledList list, USIZE num);
+void* UnrolledList_getLast(const UnrolledList list);
+void* UnrolledList_getFilter(const UnrolledList list, U8 (*match)(void*));
+
+void* UnrolledList_removeFirst(UnrolledList list);
+void* UnrolledList_removeMiddle(UnrolledList list, USIZE num);
+void* UnrolledList_removeLast(UnrolledList list);
+void* UnrolledList_removePtr(UnrolledList list, void* data);
+void* UnrolledList_removeFilter(UnrolledList list, U8 (*match)(void*));
+USIZE UnrolledList_removeAll(UnrolledList list);
+USIZE UnrolledList_removeIf(UnrolledList list, U8 (*match)(void*));
+
+USIZE UnrolledList_deleteAll(UnrolledList list);
+USIZE UnrolledList_deleteIf(UnrolledList list, U8 (*match)(void*));
+
+void UnrolledList_executeAll(const UnrolledList list, void (*todo)(void*));
+void UnrolledList_reverseExecuteAll(const UnrolledList list, void (*todo)(void*));
+USIZE UnrolledList_executeIf(const UnrolledList list, U8 (*match)(void*), void (*todo)(void*));
+
+#endif // UNROLLEDLIST_H
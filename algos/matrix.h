@@ -85,12 +85,20 @@ Matrix33 Matrix_inv33(Matrix33 m);
 
 
 
-#define Matrix_print33(mat)        UART1_printf(#mat " = [%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m21, mat.m22, mat.m23, mat.m31, mat.m32, mat.m33);
-#define  Matrix_print43(mat)       UART1_printf(#mat " = [%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m21, mat.m22, mat.m23, mat.m31, mat.m32, mat.m33, mat.m41, mat.m42, mat.m43);
-#define  Matrix_print34(mat)       UART1_printf(#mat " = [%.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m14, mat.m21, mat.m22, mat.m23, mat.m24, mat.m31, mat.m32, mat.m33, mat.m34);
-#define  Matrix_print44(mat)       UART1_printf(#mat " = [%.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m14, mat.m21, mat.m22, mat.m23, mat.m24, mat.m31, mat.m32, mat.m33, mat.m34, mat.m41, mat.m42, mat.m43, mat.m44);
-#define  Matrix_printVect(v)         UART1_printf(#v " = [%.2f,%.2f,%.2f]\r\n", , v.x, v.y, v.z);
-#define  Matrix_printQuat(q)     UART1_printf(#q " = [%.2f,%.2f,%.2f,%.2f]\r\n", q.q0, q.q1, q.q2, q.q3);
+#define Matrix_print33(mat)        UART1_sendFormat(#mat " = [%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m21, mat.m22, mat.m23, mat.m31, mat.m32, mat.m33);
+#define  Matrix_print43(mat)       UART1_sendFormat(#mat " = [%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m21, mat.m22, mat.m23, mat.m31, mat.m32, mat.m33, mat.m41, mat.m42, mat.m43);
+#define  Matrix_print34(mat)       UART1_sendFormat(#mat " = [%.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m14, mat.m21, mat.m22, mat.m23, mat.m24, mat.m31, mat.m32, mat.m33, mat.m34);
+#define  Matrix_print44(mat)       UART1_sendFormat(#mat " = [%.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f]\r\n", mat.m11, mat.m12, mat.m13, mat.m14, mat.m21, mat.m22, mat.m23, mat.m24, mat.m31, mat.m32, mat.m33, mat.m34, mat.m41, mat.m42, mat.m43, mat.m44);
+#define  Matrix_printVect(v)         UART1_sendFormat(#v " = [%.2f,%.2f,%.2f]\r\n", v.x, v.y, v.z);
+#define  Matrix_printQuat(q)     UART1_sendFormat(#q " = [%.2f,%.2f,%.2f,%.2f]\r\n", q.q0, q.q1, q.q2, q.q3);
+
+// Same as Matrix_print*, with the deferred logger (modules/Log.h): the values are sent raw, and formatted on the host by tools/logdecode.c (without the name of the variable).
+#define Matrix_log33(mat)          LOG(LOG_MATRIX33, mat.m11, mat.m12, mat.m13, mat.m21, mat.m22, mat.m23, mat.m31, mat.m32, mat.m33);
+#define Matrix_log43(mat)          LOG(LOG_MATRIX43, mat.m11, mat.m12, mat.m13, mat.m21, mat.m22, mat.m23, mat.m31, mat.m32, mat.m33, mat.m41, mat.m42, mat.m43);
+#define Matrix_log34(mat)          LOG(LOG_MATRIX34, mat.m11, mat.m12, mat.m13, mat.m14, mat.m21, mat.m22, mat.m23, mat.m24, mat.m31, mat.m32, mat.m33, mat.m34);
+#define Matrix_log44(mat)          LOG(LOG_MATRIX44, mat.m11, mat.m12, mat.m13, mat.m14, mat.m21, mat.m22, mat.m23, mat.m24, mat.m31, mat.m32, mat.m33, mat.m34, mat.m41, mat.m42, mat.m43, mat.m44);
+#define Matrix_logVect(v)          LOG(LOG_VECT, v.x, v.y, v.z);
+#define Matrix_logQuat(q)          LOG(LOG_QUAT, q.q0, q.q1, q.q2, q.q3);
 
 
 
@@ -1,31 +1,69 @@
 #ifndef __DMA_H__
 #define __DMA_H__
 
+#if defined(__XC16__) || defined(__C30__)
 #define DMA_settings ((DMA_settings_ *) 0x0380)
+#define DMA_RAM_BASE ((U8*) 0x4000)
+#else
+// host simulation (sim/p33Fxxxx.h)
+#define DMA_settings ((DMA_settings_ *) SIM_ADDR(0x0380))
+#define DMA_RAM_BASE ((U8*) SIM_ADDR(0x4000))
+#endif
+
+/// The DMA can only access the DMA RAM (2 KiB from DMA_RAM_BASE). STA and STB are offsets from its beginning.
+#define DMA_RAM_SIZE 0x0800
+#define DMA_offset(ptr) ((U16)((U8*)(ptr) - DMA_RAM_BASE))
+
+/// Maximum number of transfers of a block (CNT+1)
+#define DMA_MAX_COUNT 1024
+
+/// Requests (IRQSEL) and peripheral addresses (PAD) of the UARTs
+#define DMA_IRQ_U1RX 0x0B
+#define DMA_IRQ_U1TX 0x0C
+#define DMA_IRQ_U2RX 0x1E
+#define DMA_IRQ_U2TX 0x1F
+#define DMA_PAD_U1RXREG 0x0226
+#define DMA_PAD_U1TXREG 0x0224
+#define DMA_PAD_U2RXREG 0x0236
+#define DMA_PAD_U2TXREG 0x0234
+
+/// Clear the interrupt flag of a channel and set its priority (0 disables the interrupt)
+#define DMA_setInterrupt(channel, priority) do {\
+	switch(channel) {\
+		case 0: _DMA0IF = 0; _DMA0IP = (priority); _DMA0IE = (priority) > 0; break;\
+		case 1: _DMA1IF = 0; _DMA1IP = (priority); _DMA1IE = (priority) > 0; break;\
+		case 2: _DMA2IF = 0; _DMA2IP = (priority); _DMA2IE = (priority) > 0; break;\
+		case 3: _DMA3IF = 0; _DMA3IP = (priority); _DMA3IE = (priority) > 0; break;\
+		case 4: _DMA4IF = 0; _DMA4IP = (priority); _DMA4IE = (priority) > 0; break;\
+		case 5: _DMA5IF = 0; _DMA5IP = (priority); _DMA5IE = (priority) > 0; break;\
+		case 6: _DMA6IF = 0; _DMA6IP = (priority); _DMA6IE = (priority) > 0; break;\
+		case 7: _DMA7IF = 0; _DMA7IP = (priority); _DMA7IE = (priority) > 0; break;\
+	}\
+	} while(0)
 
 
 typedef struct {
 	union {
 		U16 CON;
 		struct {
-			unsigned int MODE : 2;
-			unsigned int  : 2;
-			unsigned int AMODE : 2;
-			unsigned int  : 5;
-			unsigned int NULLW : 1;
-			unsigned int HALF : 1;
-			unsigned int DIR : 1;
-			unsigned int SIZE : 1;
-			unsigned int CHEN : 1;
+			U16 MODE : 2;
+			U16  : 2;
+			U16 AMODE : 2;
+			U16  : 5;
+			U16 NULLW : 1;
+			U16 HALF : 1;
+			U16 DIR : 1;
+			U16 SIZE : 1;
+			U16 CHEN : 1;
 		};
 	};
 	
 	union {
 		U16 REQ;
 		struct {
-			unsigned int IRQSEL : 7;
-			unsigned int  : 8;
-			unsigned int FORCE : 1;
+			U16 IRQSEL : 7;
+			U16  : 8;
+			U16 FORCE : 1;
 		};
 	};
 	U16 STA;
@@ -34,8 +72,8 @@ typedef struct {
 	union {
 		U16 CNT_;
 		struct {
-			unsigned int CNT : 9;
-			unsigned int  : 7;
+			U16 CNT : 10;
+			U16  : 6;
 		};
 	};
 } DMA_settings_;			
@@ -0,0 +1,69 @@
+#include <p33Fxxxx.h>
+#include "../ogbwlib.h"
+#include "../algos/Framer.h"
+#include "./UART.h"
+#include "./Log.h"
+
+static UART logUart;
+static Framer logFramer;
+static U32 dropped;
+
+void Log_init(UART uart, Framer framer) {
+    logUart = uart;
+    logFramer = framer;
+    dropped = 0;
+}
+
+U8 Log_write(const U8 id, const U32* args, const U8 nb, const U16 floats) {
+    U8 record[1 + LOG_MAX_ARGS * 5];
+    ByteFIFO_Segment segment;
+    U8 size = 0;
+    U8 i;
+    if(logUart == null || nb > LOG_MAX_ARGS) {
+        return 0;
+    }
+    record[size++] = id;
+    for(i = 0; i < nb; i++) {
+        U32 value = args[i];
+        if(floats & (1U << i)) {    // the 4 bytes of the float, little endian
+            record[size++] = (U8)value;
+            record[size++] = (U8)(value >> 8);
+            record[size++] = (U8)(value >> 16);
+            record[size++] = (U8)(value >> 24);
+            continue;
+        }
+        value = (value << 1) ^ (U32)((S32)value >> 31);     // zigzag: the small negative values also get short
+        while(value >= 0x80) {      // varint: 7 bits per byte, the high bit tells that another byte follows
+            record[size++] = (U8)value | 0x80;
+            value >>= 7;
+        }
+        record[size++] = (U8)value;
+    }
+    segment.data = record;
+    segment.size = size;
+    if(UART_sendFrame(logUart, logFramer, &segment, 1) != UART_OK) {
+        INTERRUPT_PROTECT(logUart->intProtect, {   // not atomic on the dsPIC, and LOG may be called from several IPLs
+            dropped++;
+        });
+        return 0;
+    }
+    return 1;
+}
+
+U32 Log_getDroppedNb(void) {
+    U32 ret = 0;    // nothing is dropped before Log_init
+    if(logUart != null) {
+        INTERRUPT_PROTECT(logUart->intProtect, {
+            ret = dropped;
+        });
+    }
+    return ret;
+}
+
+void Log_resetDroppedNb(void) {
+    if(logUart != null) {
+        INTERRUPT_PROTECT(logUart->intProtect, {
+            dropped = 0;
+        });
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file    Log.h
+ *
+ * Deferred binary logger: instead of formatting text on the dsPIC (sprintf, thousands of cycles per float), LOG sends the id of the message and its raw arguments, as a frame (Framer.h) in the transmit buffer of a UART.
+ * The text is rebuilt on the host by tools/logdecode.c, from the format table (log_formats.h) shared by both sides.
+ *      LOG(LOG_VECT, v.x, v.y, v.z);      // 17 bytes on the line, no formatting
+ * float and double are sent as the 4 bytes of a float. Integers (up to 32 bits) are sent as zigzag varints: 1 byte from -64 to 63, 2 bytes up to +-8191, 3 up to +-1048575, 5 at most.
+ * The type is chosen at compile time (GCC builtins, available in XC16): the decoder only needs the conversions of the format, which tell it the type of each argument.
+ * With the id, the CRC and the COBS overhead, a record of floats is about as long as the text with 2 decimals (17 bytes against 18 for a vector, 69 against 94 for a Matrix44),
+ * and a record of integers is much shorter than the text (13 bytes against 65 for LOG_UART_STATS with counters below 8192).
+ *
+ * @author  ogbwJtHRXkd5H3z1RIrW2zOo
+ * @sa      log_formats.h Framer.h UART.h
+ * @version 1.0
+*/
+
+#ifndef LOG_H
+#define LOG_H
+
+#include "../typedef.h"
+#include "../algos/Framer.h"
+#include "./UART.h"
+
+#ifndef LOG_FORMATS
+#define LOG_FORMATS "log_formats.h"
+#endif
+
+/**
+ * Ids of the messages, from the format table.
+ */
+typedef enum {
+#define LOG_FORMAT(name, format) name,
+#include LOG_FORMATS
+#undef LOG_FORMAT
+    LOG_FORMAT_NB
+} Log_Id;
+
+/**
+ * Start the logger.
+ * @param uart      UART the records are sent to (e.g. &UART1_instance). It must be initialized.
+ * @param framer    framer encoding the records (it can be the one used to receive frames on this UART)
+ */
+void Log_init(UART uart, Framer framer);
+
+/**
+ * Send a record. Use LOG rather than this function.
+ * @param id        id of the message
+ * @param args      arguments, converted by LOG_ARG
+ * @param nb        number of arguments, LOG_MAX_ARGS at most
+ * @param floats    bit i set if the argument i is a float (see LOG_IS_FLOAT), else it is an integer
+ * @return          true if the record was written in the transmit buffer, false if it was full (the record is dropped and counted) or the logger is not started
+ */
+U8 Log_write(const U8 id, const U32* args, const U8 nb, const U16 floats);
+
+/**
+ * @return  number of records dropped because the transmit buffer was full, since Log_init or the last Log_resetDroppedNb
+ */
+U32 Log_getDroppedNb(void);
+void Log_resetDroppedNb(void);
+
+/// Maximal number of arguments of a record
+#define LOG_MAX_ARGS    16
+
+/**
+ * 1 if an argument of LOG is a floating point value, 0 otherwise (a compile-time constant).
+ */
+#define LOG_IS_FLOAT(x) (__builtin_types_compatible_p(__typeof__(x), float) || __builtin_types_compatible_p(__typeof__(x), double))
+
+/**
+ * An argument of LOG, as 32 bits: the bits of a float for floating point values, a cast to U32 otherwise.
+ */
+#define LOG_ARG(x)  __builtin_choose_expr(LOG_IS_FLOAT(x), ((union {float f; U32 u;}){.f = (x)}).u, (U32)(x))
+
+/**
+ * Send a message of the format table: LOG(id, arguments...), with 0 to 16 arguments.
+ * The arguments must match the conversions of the format, as for printf. The call returns the result of Log_write.
+ */
+#define LOG(...)    LOG_CAT(LOG_, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+#define LOG_CAT(a, b)   LOG_CAT_(a, b)
+#define LOG_CAT_(a, b)  a##b
+#define LOG_NARGS(...)  LOG_NARGS_(__VA_ARGS__, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define LOG_NARGS_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, n, ...) n
+#define LOG_1(id)  Log_write((id), null, 0, 0)
+#define LOG_2(id, a1)  Log_write((id), (const U32[]){LOG_ARG(a1)}, 1, LOG_IS_FLOAT(a1))
+#define LOG_3(id, a1, a2)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2)}, 2, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1)
+#define LOG_4(id, a1, a2, a3)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3)}, 3, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2)
+#define LOG_5(id, a1, a2, a3, a4)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4)}, 4, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3)
+#define LOG_6(id, a1, a2, a3, a4, a5)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5)}, 5, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4)
+#define LOG_7(id, a1, a2, a3, a4, a5, a6)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6)}, 6, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5)
+#define LOG_8(id, a1, a2, a3, a4, a5, a6, a7)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7)}, 7, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6)
+#define LOG_9(id, a1, a2, a3, a4, a5, a6, a7, a8)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8)}, 8, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7)
+#define LOG_10(id, a1, a2, a3, a4, a5, a6, a7, a8, a9)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9)}, 9, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8)
+#define LOG_11(id, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9), LOG_ARG(a10)}, 10, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8 | LOG_IS_FLOAT(a10) << 9)
+#define LOG_12(id, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9), LOG_ARG(a10), LOG_ARG(a11)}, 11, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8 | LOG_IS_FLOAT(a10) << 9 | LOG_IS_FLOAT(a11) << 10)
+#define LOG_13(id, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9), LOG_ARG(a10), LOG_ARG(a11), LOG_ARG(a12)}, 12, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8 | LOG_IS_FLOAT(a10) << 9 | LOG_IS_FLOAT(a11) << 10 | LOG_IS_FLOAT(a12) << 11)
+#define LOG_14(id, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9), LOG_ARG(a10), LOG_ARG(a11), LOG_ARG(a12), LOG_ARG(a13)}, 13, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8 | LOG_IS_FLOAT(a10) << 9 | LOG_IS_FLOAT(a11) << 10 | LOG_IS_FLOAT(a12) << 11 | LOG_IS_FLOAT(a13) << 12)
+#define LOG_15(id, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9), LOG_ARG(a10), LOG_ARG(a11), LOG_ARG(a12), LOG_ARG(a13), LOG_ARG(a14)}, 14, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8 | LOG_IS_FLOAT(a10) << 9 | LOG_IS_FLOAT(a11) << 10 | LOG_IS_FLOAT(a12) << 11 | LOG_IS_FLOAT(a13) << 12 | LOG_IS_FLOAT(a14) << 13)
+#define LOG_16(id, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9), LOG_ARG(a10), LOG_ARG(a11), LOG_ARG(a12), LOG_ARG(a13), LOG_ARG(a14), LOG_ARG(a15)}, 15, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8 | LOG_IS_FLOAT(a10) << 9 | LOG_IS_FLOAT(a11) << 10 | LOG_IS_FLOAT(a12) << 11 | LOG_IS_FLOAT(a13) << 12 | LOG_IS_FLOAT(a14) << 13 | LOG_IS_FLOAT(a15) << 14)
+#define LOG_17(id, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16)  Log_write((id), (const U32[]){LOG_ARG(a1), LOG_ARG(a2), LOG_ARG(a3), LOG_ARG(a4), LOG_ARG(a5), LOG_ARG(a6), LOG_ARG(a7), LOG_ARG(a8), LOG_ARG(a9), LOG_ARG(a10), LOG_ARG(a11), LOG_ARG(a12), LOG_ARG(a13), LOG_ARG(a14), LOG_ARG(a15), LOG_ARG(a16)}, 16, LOG_IS_FLOAT(a1) | LOG_IS_FLOAT(a2) << 1 | LOG_IS_FLOAT(a3) << 2 | LOG_IS_FLOAT(a4) << 3 | LOG_IS_FLOAT(a5) << 4 | LOG_IS_FLOAT(a6) << 5 | LOG_IS_FLOAT(a7) << 6 | LOG_IS_FLOAT(a8) << 7 | LOG_IS_FLOAT(a9) << 8 | LOG_IS_FLOAT(a10) << 9 | LOG_IS_FLOAT(a11) << 10 | LOG_IS_FLOAT(a12) << 11 | LOG_IS_FLOAT(a13) << 12 | LOG_IS_FLOAT(a14) << 13 | LOG_IS_FLOAT(a15) << 14 | LOG_IS_FLOAT(a16) << 15)
+
+#endif //LOG_H
@@ -0,0 +1,535 @@
+#include <p33Fxxxx.h>
+#include <stdarg.h>
+#include <string.h>
+#include "../ogbwlib.h"
+#include "../algos/lists/ByteFIFO.h"
+#include "../algos/Framer.h"
+#include "../algos/Format.h"
+#include "./UART.h"
+
+// UxMODE bits
+#define MODE_BRGH       0x0008
+#define MODE_UARTEN     0x8000
+// UxSTA bits
+#define STA_URXDA       0x0001
+#define STA_OERR        0x0002
+#define STA_FERR        0x0004
+#define STA_PERR        0x0008
+#define STA_RIDLE       0x0010
+#define STA_URXISEL     0x00C0
+#define STA_UTXBF       0x0200
+#define STA_UTXEN       0x0400
+#define STA_UTXISEL     0xA000
+
+#define UART_RX_BURST   5       // hardware buffer (4 bytes), plus one byte received while it is read
+
+#if defined(__XC16__) || defined(__C30__)
+#define TXREG(uart)     ((uart)->regs->TXREG)
+#define RXREG(uart)     ((uart)->regs->RXREG)
+#else
+// host simulation: UxTXREG and UxRXREG are the FIFOs of the model (sim/p33Fxxxx.h), not memory
+#define TXREG(uart)     (*sim_uartWriteTXREG((uart)->number))
+#define RXREG(uart)     (sim_uartReadRXREG((uart)->number))
+#endif
+
+/*
+ * The interrupt flags are set by the hardware at any time: they are only modified with the bit instructions generated for _UxTXIF and co, a read-modify-write through a pointer could erase an other flag.
+ */
+
+static void setTxFlag(const UART uart) {
+    if(uart->number == 1) {
+        _U1TXIF = 1;
+    } else {
+        _U2TXIF = 1;
+    }
+}
+
+static void clearTxFlag(const UART uart) {
+    if(uart->number == 1) {
+        _U1TXIF = 0;
+    } else {
+        _U2TXIF = 0;
+    }
+}
+
+static void clearRxFlag(const UART uart) {
+    if(uart->number == 1) {
+        _U1RXIF = 0;
+    } else {
+        _U2RXIF = 0;
+    }
+}
+
+static void enableTxInterrupt(const UART uart, const U8 enable) {
+    if(uart->number == 1) {
+        _U1TXIE = enable;
+    } else {
+        _U2TXIE = enable;
+    }
+}
+
+static void enableRxInterrupt(const UART uart, const U8 enable) {
+    if(uart->number == 1) {
+        _U1RXIE = enable;
+    } else {
+        _U2RXIE = enable;
+    }
+}
+
+/**
+ * Give the next contiguous part of txBuffer to the DMA, if it is idle. Must be called under interrupt protection.
+ */
+static void startTxDMA(UART uart) {
+    const void* span;
+    USIZE size;
+    if(uart->txDMASize != 0) {
+        return;
+    }
+    size = ByteFIFO_getReadSpan(uart->txBuffer, &span);
+    if(size == 0) {
+        return;
+    }
+    if(size > DMA_MAX_COUNT) {
+        size = DMA_MAX_COUNT;
+    }
+    uart->txDMASize = size;
+    DMA_settings[uart->txDMAChannel].STA = DMA_offset(span);
+    DMA_settings[uart->txDMAChannel].CNT = size - 1;
+    DMA_settings[uart->txDMAChannel].CHEN = 1;
+    if(!(uart->regs->STA & STA_UTXBF)) {    // the UART may never ask for the first byte (idle, or its request came while the channel was off): force it. When its FIFO is full, its next request will do.
+        DMA_settings[uart->txDMAChannel].FORCE = 1;
+    }
+}
+
+/**
+ * Start the transmission of the data pushed in txBuffer. Must be called under interrupt protection.
+ */
+static void startTx(UART uart) {
+    USIZE size = ByteFIFO_getDataSize(uart->txBuffer);
+    if(size > uart->stats.txHighWater) {
+        uart->stats.txHighWater = size;
+    }
+    if(uart->txDMAChannel == UART_NO_DMA) {
+        setTxFlag(uart);
+    } else {
+        startTxDMA(uart);
+    }
+}
+
+/**
+ * Hand received bytes to the consumer, or to rxBuffer if there is none. Must be called under interrupt protection.
+ */
+static void deliverRx(UART uart, const U8* data, U16 size) {
+    if(size == 0) {
+        return;
+    }
+    if(uart->rxDMAConsumer != null) {
+        uart->rxDMAConsumer(data, size);
+        uart->stats.rxBytes += size;
+    } else {
+        USIZE pushed = ByteFIFO_pushAvailable(uart->rxBuffer, size, data);
+        uart->stats.rxBytes += pushed;
+        if(pushed != size) {
+            uart->stats.rxOverflows += size - pushed;
+            uart->rxErrors |= UART_RX_ERR_OVERFLOW;
+        }
+        if(ByteFIFO_getDataSize(uart->rxBuffer) > uart->stats.rxHighWater) {
+            uart->stats.rxHighWater = ByteFIFO_getDataSize(uart->rxBuffer);
+        }
+    }
+}
+
+/**
+ * Hand over the characters [from, to) of a half of the RX DMA RAM, and free their words for the DMA. Must be called under interrupt protection.
+ */
+static void deliverRxDMA(UART uart, U16* half, U16 from, U16 to) {
+    U8* bytes = (U8*) (half + from);
+    U16 i;
+    for(i = from; i < to; i++) {    // packed in place: the byte i - from is written over a word already read
+        bytes[i - from] = (U8) half[i];
+    }
+    deliverRx(uart, bytes, to - from);
+    for(i = from; i < to; i++) {
+        half[i] = UART_RX_DMA_FREE;
+    }
+}
+
+UART_Error UART_init(UART uart, U8 txPin, U16 txBufferSize, U8 txIntPriority, U8 rxPin, U16 rxBufferSize, U8 rxIntPriority, U32 baudrate, U8 intProtect) {
+    // We are in a memory well-controlled environnement. If this fail, the programmer made a critical mistake. We don't even try to recover, let's just return an error code.
+    uart->txBuffer = ByteFIFO_new(txBufferSize);
+    uart->rxBuffer = ByteFIFO_new(rxBufferSize);
+    uart->txDMAChannel = UART_NO_DMA;
+    uart->rxDMAChannel = UART_NO_DMA;
+    uart->rxErrors = 0;
+    memset(&uart->stats, 0, sizeof(uart->stats));     // not UART_resetStats: intProtect is not set yet, and the UART interrupts are enabled further down
+
+    if(uart->txBuffer == null || uart->rxBuffer == null) {
+        return UART_OUT_OF_MEMORY;
+    }
+
+    // Port Mapping
+    if(uart->number == 1) {
+        PPSInput(U1RX, rxPin);
+        PPSOutput(U1TX, txPin);
+    } else {
+        PPSInput(U2RX, rxPin);
+        PPSOutput(U2TX, txPin);
+    }
+
+    // Baudrate setting
+    uart->regs->MODE = MODE_BRGH; // fast mode (works for baurates from ~200bps (@Fcy=40MHz) to several Mbps)
+    uart->regs->BRG = ((FCY / baudrate) / 4) - 1;
+    uart->regs->STA = 0; // URXISEL = 0: interrupt for each byte received
+
+    // Interruption initialisation
+    if(intProtect>txIntPriority && intProtect>rxIntPriority) {
+        uart->intProtect = intProtect;
+    } else {
+        uart->intProtect =   txIntPriority>rxIntPriority ? txIntPriority : rxIntPriority;
+    }
+
+    if(uart->number == 1) {
+        _U1TXIF = 0;
+        _U1TXIP = txIntPriority;
+        _U1RXIF = 0;
+        _U1RXIP = rxIntPriority;
+    } else {
+        _U2TXIF = 0;
+        _U2TXIP = txIntPriority;
+        _U2RXIF = 0;
+        _U2RXIP = rxIntPriority;
+    }
+    enableTxInterrupt(uart, 1);
+    enableRxInterrupt(uart, rxIntPriority>0?1:0);
+
+    // Start module
+    uart->regs->MODE |= MODE_UARTEN;
+    uart->regs->STA |= STA_UTXEN;
+
+    return UART_OK;
+}
+
+UART_Error UART_initTxDMA(UART uart, U8 channel, U8 dmaIntPriority, void* dmaRam, U16 dmaRamSize) {
+    ByteFIFO buffer = ByteFIFO_init(dmaRam, dmaRamSize);
+    if(buffer == null) {
+        return UART_OUT_OF_MEMORY;
+    }
+
+    enableTxInterrupt(uart, 0);
+    uart->regs->STA &= ~STA_UTXISEL;   // the DMA needs a request for each byte
+    ByteFIFO_free(uart->txBuffer);
+    uart->txBuffer = buffer;
+    uart->txDMAChannel = channel;
+    uart->txDMASize = 0;
+
+    // One-shot blocks of bytes, from the DMA RAM to UxTXREG, one byte each time the UART has room for it (UTXISEL = 0)
+    DMA_settings[channel].CON = 0;
+    DMA_settings[channel].MODE = 1;
+    DMA_settings[channel].DIR = 1;
+    DMA_settings[channel].SIZE = 1;
+    DMA_settings[channel].REQ = uart->txIrq;
+    DMA_settings[channel].PAD = uart->txPad;
+    DMA_setInterrupt(channel, dmaIntPriority);
+
+    if(dmaIntPriority > uart->intProtect) {
+        uart->intProtect = dmaIntPriority;
+    }
+    return UART_OK;
+}
+
+UART_Error UART_initRxDMA(UART uart, U8 channel, U8 dmaIntPriority, void* dmaRam, U16 halfSize, void (*consumer)(const void*, U16)) {
+    U16 i;
+    if(halfSize == 0 || halfSize > DMA_MAX_COUNT) {
+        return UART_OUT_OF_MEMORY;
+    }
+
+    enableRxInterrupt(uart, 0);
+    uart->regs->STA &= ~STA_URXISEL;   // the DMA needs a request for each byte
+    uart->rxDMAChannel = channel;
+    uart->rxDMABuffer = dmaRam;
+    uart->rxDMAHalfSize = halfSize;
+    uart->rxDMAHalf = 0;
+    uart->rxDMAConsumed = 0;
+    uart->rxDMAConsumer = consumer;
+    for(i = 0; i < 2 * halfSize; i++) {
+        uart->rxDMABuffer[i] = UART_RX_DMA_FREE;
+    }
+
+    // Continuous ping-pong blocks of words, from UxRXREG to the two halves of dmaRam, one word each time the UART receives a character (URXISEL = 0).
+    // Words and not bytes, so that the free ones can be told apart: UART_flushRxDMA finds how far the current half is filled without DSADR, which the other channels overwrite.
+    DMA_settings[channel].CON = 0;
+    DMA_settings[channel].MODE = 2;
+    DMA_settings[channel].SIZE = 0;
+    DMA_settings[channel].REQ = uart->rxIrq;
+    DMA_settings[channel].PAD = uart->rxPad;
+    DMA_settings[channel].STA = DMA_offset(dmaRam);
+    DMA_settings[channel].STB = DMA_offset(dmaRam) + 2 * halfSize;
+    DMA_settings[channel].CNT = halfSize - 1;
+    DMA_setInterrupt(channel, dmaIntPriority);
+
+    if(dmaIntPriority > uart->intProtect) {
+        uart->intProtect = dmaIntPriority;
+    }
+    DMA_settings[channel].CHEN = 1;
+    return UART_OK;
+}
+
+UART_Error UART_sendByte(UART uart, S8 b) {
+    ByteFIFO_Error ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_pushByte(uart->txBuffer, b);
+        startTx(uart);
+    });
+    return ret == ByteFIFO_OK ? UART_OK : UART_BUFFER_OVERFLOW;
+}
+
+UART_Error UART_sendTab(UART uart, const void * tab, U16 size) {
+    ByteFIFO_Error ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_pushBlock(uart->txBuffer, size, tab);
+        startTx(uart);
+    });
+    return ret == ByteFIFO_OK ? UART_OK : UART_BUFFER_OVERFLOW;
+}
+
+UART_Error UART_sendStr(UART uart, const char* str) {
+    ByteFIFO_Error ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_pushStr(uart->txBuffer, str);
+        startTx(uart);
+    });
+    return ret == ByteFIFO_OK ? UART_OK : UART_BUFFER_OVERFLOW;
+}
+
+UART_Error UART_sendVector(UART uart, const ByteFIFO_Segment* segments, U16 nb) {
+    ByteFIFO_Error ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_pushVector(uart->txBuffer, segments, nb);
+        startTx(uart);
+    });
+    return ret == ByteFIFO_OK ? UART_OK : UART_BUFFER_OVERFLOW;
+}
+
+UART_Error UART_sendFormat(UART uart, const char* format, ...) {
+    ByteFIFO_Error ret;
+    va_list args;
+    va_start(args, format);
+    INTERRUPT_PROTECT(uart->intProtect, {  // the text is written in place: another send must not push in its span meanwhile
+        ret = Format_vprint(uart->txBuffer, format, args);
+        startTx(uart);
+    });
+    va_end(args);
+    return ret == ByteFIFO_OK ? UART_OK : UART_BUFFER_OVERFLOW;
+}
+
+UART_Error UART_sendFrame(UART uart, Framer framer, const ByteFIFO_Segment* segments, U16 nb) {
+    ByteFIFO_Error ret;
+    const U16 crc = Framer_crc(segments, nb);   // the longest part, done without protection
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = Framer_encodeWithCrc(framer, uart->txBuffer, segments, nb, crc);
+        startTx(uart);
+    });
+    return ret == ByteFIFO_OK ? UART_OK : UART_BUFFER_OVERFLOW;
+}
+
+U16 UART_receiveFrames(UART uart, Framer framer) {
+    U16 ret = 0;
+    const void* data;
+    USIZE size;
+    for(;;) {
+        INTERRUPT_PROTECT(uart->intProtect, {
+            size = ByteFIFO_getReadSpan(uart->rxBuffer, &data);
+        });
+        if(size == 0) {
+            return ret;
+        }
+        ret += Framer_decodeBytes(framer, data, size);  // the receive interrupt only writes after these bytes: no need to protect the decoding
+        INTERRUPT_PROTECT(uart->intProtect, {
+            ByteFIFO_skip(uart->rxBuffer, size);
+        });
+    }
+}
+
+U16 UART_getRxBufferDataSize(UART uart) {
+    U16 ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_getDataSize(uart->rxBuffer);
+    });
+    return ret;
+}
+
+S8 UART_readByte(UART uart) {
+    S8 ret=0;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        if(ByteFIFO_isNotEmpty(uart->rxBuffer)) { // ByteFIFO_pop has no protection against pop on empty FIFO. We don't want UART to transmit this responsability to the user.
+            ret = ByteFIFO_pop(uart->rxBuffer);
+        }
+    });
+    return ret;
+}
+
+UART_Error UART_readTab(UART uart, void* data, U16 size) {
+    ByteFIFO_Error ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_popBlock(uart->rxBuffer, size, data);
+    });
+    return ret == ByteFIFO_OK ? UART_OK : UART_NOT_ENOUGHT_DATA;
+}
+
+U16 UART_readAvailable(UART uart, void* data, U16 size) {
+    U16 ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_popAvailable(uart->rxBuffer, size, data);
+    });
+    return ret;
+}
+
+void UART_onTxDMAInterrupt(UART uart) {
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ByteFIFO_skip(uart->txBuffer, uart->txDMASize);
+        uart->stats.txBytes += uart->txDMASize;
+        uart->txDMASize = 0;
+        startTxDMA(uart);
+    });
+}
+
+void UART_onRxDMAInterrupt(UART uart) {
+    INTERRUPT_PROTECT(uart->intProtect, {
+        U16* half = uart->rxDMABuffer + (uart->rxDMAHalf ? uart->rxDMAHalfSize : 0);
+        deliverRxDMA(uart, half, uart->rxDMAConsumed, uart->rxDMAHalfSize);
+        uart->rxDMAConsumed = 0;
+        uart->rxDMAHalf ^= 1;
+    });
+}
+
+U16 UART_flushRxDMA(UART uart) {
+    U16 ret = 0;
+    if(uart->rxDMAChannel == UART_NO_DMA) {
+        return 0;
+    }
+    INTERRUPT_PROTECT(uart->intProtect, {
+        U16* half = uart->rxDMABuffer + (uart->rxDMAHalf ? uart->rxDMAHalfSize : 0);
+        U16 end = uart->rxDMAConsumed;
+        if((uart->regs->STA & (STA_RIDLE | STA_URXDA)) == STA_RIDLE) {
+            // The DMA fills the words in order: the characters received are the ones before the first free word.
+            while(end < uart->rxDMAHalfSize && half[end] != UART_RX_DMA_FREE) {
+                end++;
+            }
+            // A full half is left to UART_onRxDMAInterrupt, whose interrupt is pending.
+            if(end < uart->rxDMAHalfSize) {
+                ret = end - uart->rxDMAConsumed;
+                deliverRxDMA(uart, half, uart->rxDMAConsumed, end);
+                uart->rxDMAConsumed = end;
+            }
+        }
+    });
+    return ret;
+}
+
+void UART_onTxInterrupt(UART uart) {
+    clearTxFlag(uart);
+    INTERRUPT_PROTECT(uart->intProtect, {
+        while (!(uart->regs->STA & STA_UTXBF) && ByteFIFO_isNotEmpty(uart->txBuffer)) {
+            TXREG(uart) = ByteFIFO_pop(uart->txBuffer);
+            uart->stats.txBytes++;
+        }
+    });
+}
+
+/**
+ * Move the bytes of the hardware buffer to rxBuffer, and clear an overrun. Must be called under interrupt protection.
+ * The bytes are first read in a local burst, pushed in rxBuffer with a single block write: the ByteFIFO cost is paid once per burst, not per byte.
+ */
+static UART_Error drainRx(UART uart) {
+    UART_Error ret = UART_OK;
+    U8 burst[UART_RX_BURST];
+    U16 sta;
+    USIZE pushed;
+    U8 nb;
+
+    do {
+        nb = 0;
+        while(((sta = uart->regs->STA) & STA_URXDA) && nb < UART_RX_BURST) {
+            if(sta & (STA_FERR | STA_PERR)) {   // FERR and PERR describe the byte at the top of the hardware buffer: check them before reading it
+                (void)RXREG(uart);
+                uart->rxErrors |= (sta & STA_FERR) ? UART_RX_ERR_FRAMING : UART_RX_ERR_PARITY;
+                uart->stats.rxErrors++;
+            } else {
+                burst[nb++] = RXREG(uart);
+            }
+        }
+        pushed = ByteFIFO_pushAvailable(uart->rxBuffer, nb, burst);
+        uart->stats.rxBytes += pushed;
+        if(pushed != nb) {
+            uart->stats.rxOverflows += nb - pushed;
+            uart->rxErrors |= UART_RX_ERR_OVERFLOW;
+            ret = UART_BUFFER_OVERFLOW;
+        }
+    } while(nb == UART_RX_BURST);   // a byte may have arrived meanwhile
+
+    if(ByteFIFO_getDataSize(uart->rxBuffer) > uart->stats.rxHighWater) {
+        uart->stats.rxHighWater = ByteFIFO_getDataSize(uart->rxBuffer);
+    }
+    if(sta & STA_OERR) {   // the module stops receiving until OERR is cleared (which also empties its buffer, already read)
+        uart->regs->STA &= ~STA_OERR;
+        uart->rxErrors |= UART_RX_ERR_OVERRUN;
+        uart->stats.overruns++;
+    }
+    return ret;
+}
+
+UART_Error UART_onRxInterrupt(UART uart) {
+    UART_Error ret;
+    clearRxFlag(uart);
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = drainRx(uart);
+    });
+    return ret;
+}
+
+U16 UART_onRxTimeout(UART uart) {
+    U16 ret;
+    if(uart->rxDMAChannel != UART_NO_DMA) {
+        return UART_flushRxDMA(uart);
+    }
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = ByteFIFO_getDataSize(uart->rxBuffer);
+        drainRx(uart);
+        ret = ByteFIFO_getDataSize(uart->rxBuffer) - ret;
+    });
+    return ret;
+}
+
+void UART_setInterruptThresholds(UART uart, UART_TxInterrupt tx, UART_RxInterrupt rx) {
+    INTERRUPT_PROTECT(uart->intProtect, {
+        U16 sta = uart->regs->STA;
+        if(uart->txDMAChannel == UART_NO_DMA) {
+            sta = (sta & ~STA_UTXISEL) | tx;
+        }
+        if(uart->rxDMAChannel == UART_NO_DMA) {
+            sta = (sta & ~STA_URXISEL) | rx;
+        }
+        uart->regs->STA = sta;
+    });
+}
+
+U8 UART_getRxErrors(UART uart) {
+    U8 ret;
+    INTERRUPT_PROTECT(uart->intProtect, {
+        ret = uart->rxErrors;
+        uart->rxErrors = 0;
+    });
+    return ret;
+}
+
+void UART_getStats(UART uart, UART_Stats* stats) {
+    INTERRUPT_PROTECT(uart->intProtect, {
+        *stats = uart->stats;
+    });
+}
+
+void UART_resetStats(UART uart) {
+    INTERRUPT_PROTECT(uart->intProtect, {
+        memset(&uart->stats, 0, sizeof(uart->stats));
+    });
+}
@@ -0,0 +1,215 @@
+/**
+ * @file    UART.h
+ *
+ * UART driver with buffering, shared by all the UART modules of the dsPIC.
+ * Every function works on a UART handle: the state of a module (registers, buffers, DMA, statistics) is in its struct UART_struct, so that a single code serves UART1 and UART2.
+ * UART1.h and UART2.h define the handles UART1_instance and UART2_instance, and the UART1_ and UART2_ macros calling these functions on them: most of the time, you will use these rather than this file.
+ * Internally uses ByteFIFO for buffering, which means space is allocated with malloc, and therefore linker set to allocate some space on the heap.
+ *
+ * @author  ogbwJtHRXkd5H3z1RIrW2zOo
+ * @sa      ByteFIFO.h UART1.h UART2.h
+ * @version 2.0
+*/
+
+#ifndef UART_H
+#define UART_H
+
+#include "../typedef.h"
+#include "../algos/lists/ByteFIFO.h"
+#include "../algos/Framer.h"
+
+#ifndef UART_Error_declaration
+#define UART_Error_declaration
+typedef enum {
+    UART_OK,
+    UART_OUT_OF_MEMORY,
+    UART_NOT_ENOUGHT_DATA,
+    UART_BUFFER_OVERFLOW
+} UART_Error;
+#endif
+
+/**
+ * Registers of a UART module, in the order of the SFR (UxMODE, UxSTA, UxTXREG, UxRXREG, UxBRG).
+ */
+typedef struct {
+    U16 MODE;
+    U16 STA;
+    U16 TXREG;
+    U16 RXREG;
+    U16 BRG;
+} UART_Registers;
+
+/**
+ * Statistics of a UART, since UART_init or the last UART_resetStats.
+ */
+typedef struct {
+    U32 txBytes;        /// bytes given to the hardware module (directly or by the DMA)
+    U32 rxBytes;        /// bytes received and stored in the receive buffer (or given to the DMA consumer)
+    U32 rxOverflows;    /// bytes lost because the receive buffer was full
+    U32 overruns;       /// hardware overruns (OERR): at least one byte lost because the 4 bytes hardware buffer was not read in time
+    U32 rxErrors;       /// bytes received with a framing (FERR) or parity (PERR) error, dropped
+    USIZE txHighWater;  /// maximum number of bytes waiting in the transmit buffer
+    USIZE rxHighWater;  /// maximum number of bytes waiting in the receive buffer
+} UART_Stats;
+
+/**
+ * When the transmit interrupt is requested (UTXISEL bits of UxSTA).
+ */
+typedef enum {
+    UART_TX_INT_EACH_BYTE = 0x0000,     /// each time a byte leaves the 4 bytes hardware buffer: one interrupt per byte, but the ISR can be delayed up to 3 characters without pausing the line
+    UART_TX_INT_BUFFER_EMPTY = 0x8000   /// when the hardware buffer becomes empty: the ISR refills it with 4 bytes at once (one interrupt per 4 bytes), but it must run within 1 character to keep the line busy
+} UART_TxInterrupt;
+
+/**
+ * When the receive interrupt is requested (URXISEL bits of UxSTA).
+ */
+typedef enum {
+    UART_RX_INT_EACH_BYTE = 0x0000,     /// each byte received: one interrupt per byte, the ISR can be delayed up to 4 characters
+    UART_RX_INT_3_4_FULL = 0x0080       /// 3 bytes in the 4 bytes hardware buffer: one interrupt per 3 bytes, the ISR must run within 1 character. The last 1 or 2 bytes of a message are only read by UART_onRxTimeout.
+} UART_RxInterrupt;
+
+/**
+ * Reception errors, as returned by UART_getRxErrors. Several of them can be combined.
+ */
+typedef enum {
+    UART_RX_ERR_OVERRUN = 0x01,     /// overrun of the hardware buffer (OERR): bytes lost before the interrupt could read them
+    UART_RX_ERR_FRAMING = 0x02,     /// byte received without its stop bit (FERR, wrong baudrate or noise), dropped
+    UART_RX_ERR_PARITY = 0x04,      /// byte received with a wrong parity bit (PERR), dropped
+    UART_RX_ERR_OVERFLOW = 0x08     /// receive buffer full: bytes lost
+} UART_RxError;
+
+struct UART_struct {
+    volatile UART_Registers* regs;  /// registers of the module
+    U8 number;                      /// n° of the module (1 for UART1...)
+    U8 txIrq;                       /// DMA request of the module transmitter (IRQSEL)
+    U16 txPad;                      /// address of UxTXREG for the DMA (PAD)
+    U8 rxIrq;                       /// DMA request of the module receiver (IRQSEL)
+    U16 rxPad;                      /// address of UxRXREG for the DMA (PAD)
+
+    U8 intProtect;                  /// IPL protecting the buffers
+    ByteFIFO txBuffer;
+    ByteFIFO rxBuffer;
+
+    U8 txDMAChannel;                /// DMA channel used for transmission, UART_NO_DMA if none
+    USIZE txDMASize;                /// number of bytes of txBuffer being sent by the DMA
+    U8 rxDMAChannel;                /// DMA channel used for reception, UART_NO_DMA if none
+    U16* rxDMABuffer;               /// the two halves, one after the other, one word per character (UART_RX_DMA_FREE if none received yet)
+    U16 rxDMAHalfSize;              /// number of characters of a half
+    U8 rxDMAHalf;                   /// half being filled by the DMA
+    U16 rxDMAConsumed;              /// number of characters of this half already handed over by UART_flushRxDMA
+    void (*rxDMAConsumer)(const void*, U16);
+
+    U8 rxErrors;                    /// UART_RxError flags since the last UART_getRxErrors
+
+    UART_Stats stats;
+};
+typedef struct UART_struct* UART;
+
+#define UART_NO_DMA 0xFF
+/// Value of the free words of the RX DMA halves: never read in UxRXREG, whose bits 9 to 15 are 0
+#define UART_RX_DMA_FREE 0xFFFF
+
+/**
+ * Initializer of a struct UART_struct, for the module n.
+ * Only the constant fields are set, the rest is done by UART_init.
+ */
+#define UART_INSTANCE(n) {.regs = (volatile UART_Registers*)&U##n##MODE, .number = n, \
+                          .txIrq = DMA_IRQ_U##n##TX, .txPad = DMA_PAD_U##n##TXREG, .rxIrq = DMA_IRQ_U##n##RX, .rxPad = DMA_PAD_U##n##RXREG}
+
+/**
+ * UART initialization.     This function sets pins, initialize buffer, interrputs, and hardware module. The UART in usable imediatly after a call to this function.
+ * @param txPin             N° of the pin used for UxTX output (5 means RP5, not the n°5 pin of the dsPIC)
+ * @param txBufferSize      transmission buffer size.
+ * @param txIntPriority     transmission interrupt priority. This interrput reads data from the buffer and manages the hardware module. High priority is strongly advised.
+ * @param rxPin             N° of the pin used for UxRX input (4 means RP4, not the n°4 pin of the dsPIC)
+ * @param rxBufferSize      receive buffer size
+ * @param rxIntPriority     receive interrupt priority. Keep in mind that if it can't be executed while more than 4 bytes are recieved, you may lose some data.
+ * @param baudrate          Transmission speed, in bps
+ * @param intProtect        Highest IPL at which the user code is susceptible too use the UART. This is important to protect the buffer reads and write. If you don't know, and no time-sensitive interrupt exists, 7 is a good choice.
+ * @return                  UART_OUT_OF_MEMORY if heap size was not enought to start.
+ * @return                  UART_OK if the initiallization was successfull.
+ * @warning                 Internally uses ByteFIFO: the heap must hold txBufferSize + rxBufferSize + 24 bytes.
+ */
+UART_Error UART_init(UART uart, U8 txPin, U16 txBufferSize, U8 txIntPriority, U8 rxPin, U16 rxBufferSize, U8 rxIntPriority, U32 baudrate, U8 intProtect);
+
+UART_Error UART_initTxDMA(UART uart, U8 channel, U8 dmaIntPriority, void* dmaRam, U16 dmaRamSize);
+UART_Error UART_initRxDMA(UART uart, U8 channel, U8 dmaIntPriority, void* dmaRam, U16 halfSize, void (*consumer)(const void*, U16));
+
+UART_Error UART_sendByte(UART uart, S8 b);
+UART_Error UART_sendTab(UART uart, const void* tab, U16 size);
+UART_Error UART_sendStr(UART uart, const char* str);
+UART_Error UART_sendVector(UART uart, const ByteFIFO_Segment* segments, U16 nb);
+
+/**
+ * Send formatted text (Format.c: integers, and floats with a fixed number of decimals): the text is written directly in the transmit buffer, without sprintf nor intermediate buffer.
+ * The interrupts up to intProtect are masked during the whole formatting, as another send must not push in the buffer while the text is written in its free space.
+ * The latency it adds grows with the text: keep the texts short where it matters (a %f costs several %d), or send them from the main loop only, with a lower intProtect.
+ * @return  UART_BUFFER_OVERFLOW if the transmit buffer didn't have enought space for the whole text. In this case, nothing is written.
+ * @return  UART_OK if the text was written.
+ */
+UART_Error UART_sendFormat(UART uart, const char* format, ...);
+
+/**
+ * Send a frame: the segments are encoded by the framer (COBS, with a CRC) directly in the transmit buffer, as a single message.
+ * The CRC is computed before masking the interrupts: only the COBS encoding and the copy in the buffer are protected.
+ * @return  UART_BUFFER_OVERFLOW if the transmit buffer may not have enought space for the encoded frame (Framer_encodedSize). In this case, nothing is written.
+ * @return  UART_OK if the frame was written.
+ */
+UART_Error UART_sendFrame(UART uart, Framer framer, const ByteFIFO_Segment* segments, U16 nb);
+
+/**
+ * Decode the receive buffer with a framer: the valid frames are written in its output ObjectFIFO, the bytes are removed from the receive buffer.
+ * The bytes are decoded where they are, without copy and without blocking the receive interrupt, which keeps writing after them.
+ * Call it from the main loop, or from a low priority interrupt (it must be the only reader of the receive buffer).
+ * @return  number of frames written in the output ObjectFIFO
+ * @remark  With UART_initRxDMA, the receive buffer is only used if there is no consumer: alternatively, the consumer can call Framer_decodeBytes directly on the DMA RAM.
+ */
+U16 UART_receiveFrames(UART uart, Framer framer);
+
+U16 UART_getRxBufferDataSize(UART uart);
+S8 UART_readByte(UART uart);
+UART_Error UART_readTab(UART uart, void* tab, U16 size);
+U16 UART_readAvailable(UART uart, void* tab, U16 size);
+
+void UART_onTxInterrupt(UART uart);
+UART_Error UART_onRxInterrupt(UART uart);
+void UART_onTxDMAInterrupt(UART uart);
+void UART_onRxDMAInterrupt(UART uart);
+U16 UART_flushRxDMA(UART uart);
+
+/**
+ * Receive timeout: read the bytes waiting in the hardware buffer, that do not reach the threshold of UART_RX_INT_3_4_FULL (with UART_initRxDMA, does UART_flushRxDMA instead).
+ * Call it periodically, e.g. from a timer interrupt every few characters times: its period is the worst-case delay before a received byte is available. It must have a priority at most equal to intProtect.
+ * @return  number of bytes moved to the receive buffer
+ */
+U16 UART_onRxTimeout(UART uart);
+
+/**
+ * Choose when the transmit and receive interrupts are requested (by default, UART_TX_INT_EACH_BYTE and UART_RX_INT_EACH_BYTE).
+ * Fewer interrupts mean less CPU time spent entering and leaving the ISR, but a shorter delay allowed before they run: check the priorities, and call UART_onRxTimeout periodically with UART_RX_INT_3_4_FULL.
+ * @param tx    transmit interrupt threshold, ignored if the transmission uses the DMA
+ * @param rx    receive interrupt threshold, ignored if the reception uses the DMA
+ * @warning     Call it after UART_init, UART_initTxDMA and UART_initRxDMA.
+ */
+void UART_setInterruptThresholds(UART uart, UART_TxInterrupt tx, UART_RxInterrupt rx);
+
+/**
+ * Get the reception errors that occurred since the last call, and clear them.
+ * Unlike the statistics, this is meant to be polled by the application, e.g. to resynchronize a protocol after a loss.
+ * @return  combination of UART_RxError flags, 0 if no error occurred
+ * @remark  The errors of the bytes received by the DMA (UART_initRxDMA) are not checked, except UART_RX_ERR_OVERFLOW.
+ */
+U8 UART_getRxErrors(UART uart);
+
+/**
+ * Get the statistics of a UART.
+ * @param stats     where the statistics are copied (in one piece, under interrupt protection)
+ */
+void UART_getStats(UART uart, UART_Stats* stats);
+
+/**
+ * Reset all the statistics of a UART to 0.
+ */
+void UART_resetStats(UART uart);
+
+#endif //UART_H
@@ -4,10 +4,11 @@
  * Library providing UART2 management, with buffering.
  * It needs ISR for both RX and TX correctly set to work properly. You can either use the macros UART2_setU2RXInterruptForMe and UART2_setU2TXInterruptForMe for basic use (no overflow management, no read in interrupt body...), or you can define your own ISR based on the ones set by the macros.
  * Internally uses ByteFIFO for buffering, which means space is allocated with malloc, and therefore linker set to allocate some space on the heap.
+ * The functions are macros calling the common UART driver (UART.h) on UART2_instance.
  *
  * @author  ogbwJtHRXkd5H3z1RIrW2zOo
- * @sa      ByteFIFO.h UART2.h
- * @version 1.1
+ * @sa      UART.h ByteFIFO.h UART2.h
+ * @version 2.0
 */
 
 #ifndef UART2_H
@@ -15,17 +16,12 @@
 
 #include "../typedef.h"
 #include "../algos/lists/ByteFIFO.h"
+#include "./UART.h"
 
-#ifndef UART_Error_declaration
-#define UART_Error_declaration
-typedef enum {
-    UART_OK,
-    UART_OUT_OF_MEMORY,
-    UART_NOT_ENOUGHT_DATA,
-    UART_BUFFER_OVERFLOW
-} UART_Error;
-#endif
-
+/**
+ * State of UART2, for the functions of UART.h.
+ */
+extern struct UART_struct UART2_instance;
 
 /**
  * UART2 initialization.    This function sets pins, initialize buffer, interrputs, and hardware module. UART2 in usable imediatly after a call to this function.
@@ -42,7 +38,57 @@ typedef enum {
  * @warning                 _U2TXInterrupt and _U2RXInterrupt must be correctly set. You can use UART2_setU2RXInterruptForMe and UART2_setU2TXInterruptForMe, or derive their code for your personnal use.
  * @warning                 Internally uses ByteFIFO. You must set the linker to allocate a heap sapce allowing two ByteFIFO with a txBufferSize and rxBufferSize size. With the current implementation of ByteFIFO, it means txBufferSize + rxBufferSize + 16 byte in the heap, but you should keep a margin to take into account future evolutions, or allignement constraints.
  */
-UART_Error UART2_init(U8 txPin, U16 txBufferSize, U8 txIntPriority, U8 rxPin, U16 rxBufferSize, U8 rxIntPriority, U32 baudrate, U8 intProtect);
+#define UART2_init(txPin, txBufferSize, txIntPriority, rxPin, rxBufferSize, rxIntPriority, baudrate, intProtect) UART_init(&UART2_instance, (txPin), (txBufferSize), (txIntPriority), (rxPin), (rxBufferSize), (rxIntPriority), (baudrate), (intProtect))
+
+/**
+ * Switch the transmission of UART2 to a DMA channel: instead of a _U2TXInterrupt per 4 bytes that copies the bytes one by one into U2TXREG,
+ * the DMA sends whole contiguous parts of the transmit buffer, with one interrupt per part.
+ * The transmit buffer is moved to dmaRam (the DMA can only read the DMA RAM), the one allocated by UART2_init is freed.
+ * @param channel           DMA channel to use (0 to 7)
+ * @param dmaIntPriority    priority of the DMA channel interrupt, which starts the transfer of the next part. Must not be 0.
+ * @param dmaRam            memory in the DMA RAM for the transmit buffer (e.g. static U8 txDmaRam[256] __attribute__((space(dma)));), aligned on 2 bytes
+ * @param dmaRamSize        size of dmaRam. The transmit buffer can hold dmaRamSize - 12 bytes.
+ * @return                  UART_OUT_OF_MEMORY if dmaRamSize is too small. In this case, the transmission is still done by _U2TXInterrupt.
+ * @return                  UART_OK if the DMA is set.
+ * @warning                 Call it just after UART2_init, before anything is sent. The _DMAxInterrupt of the channel must call UART2_onTxDMAInterrupt (see UART2_setTxDMAInterruptForMe). _U2TXInterrupt is no longer used.
+ */
+#define UART2_initTxDMA(channel, dmaIntPriority, dmaRam, dmaRamSize) UART_initTxDMA(&UART2_instance, (channel), (dmaIntPriority), (dmaRam), (dmaRamSize))
+
+/**
+ * Switch the reception of UART2 to a DMA channel in ping-pong mode: the DMA writes the received characters alternately in two halves of dmaRam, one word each,
+ * and there is one interrupt per half filled instead of one _U2RXInterrupt per byte. At high baudrates, this is what prevents the 4 bytes hardware buffer from overflowing.
+ * Each half is handed over when it is full, or earlier by UART2_flushRxDMA when the line becomes idle (end of a message shorter than a half).
+ * @param channel           DMA channel to use (0 to 7)
+ * @param dmaIntPriority    priority of the DMA channel interrupt, which hands the halves over. Must not be 0.
+ * @param dmaRam            2 * halfSize words in the DMA RAM (e.g. static U16 rxDmaRam[128] __attribute__((space(dma)));). The words are packed in bytes in place when handed over.
+ * @param halfSize          number of characters of each half, 1 to DMA_MAX_COUNT. The DMA interrupt must be executed within halfSize characters, or the data will be overwritten.
+ * @param consumer          function receiving the data, directly in dmaRam (zero-copy): consumer(ptr to the first byte, number of bytes). It is called under interrupt protection, from the DMA interrupt or UART2_flushRxDMA, so keep it short.
+ *                          If null, the data is copied in the receive buffer, and read as usual (UART2_readByte, UART2_readAvailable...).
+ * @return                  UART_OUT_OF_MEMORY if halfSize is 0 or too big. In this case, the reception is still done by _U2RXInterrupt.
+ * @return                  UART_OK if the DMA is set.
+ * @warning                 Call it just after UART2_init, before anything is received. The _DMAxInterrupt of the channel must call UART2_onRxDMAInterrupt (see UART2_setRxDMAInterruptForMe). _U2RXInterrupt is no longer used.
+ */
+#define UART2_initRxDMA(channel, dmaIntPriority, dmaRam, halfSize, consumer) UART_initRxDMA(&UART2_instance, (channel), (dmaIntPriority), (dmaRam), (halfSize), (consumer))
+
+/**
+ * Hand over the bytes received by the DMA since the last half was completed, if the line is idle. Without it, the end of a message stays in the DMA RAM until enought bytes are received to fill the half.
+ * Call it periodically (e.g. from a timer interrupt, every few characters times: this is the receive timeout), at an IPL below the intProtect given to UART2_init.
+ * @return      number of bytes handed over. Nothing is done while a character is being received, or if UART2_initRxDMA is not used.
+ */
+#define UART2_flushRxDMA() UART_flushRxDMA(&UART2_instance)
+
+/**
+ * Choose when _U2TXInterrupt and _U2RXInterrupt are requested, to have fewer interrupts (see UART_TxInterrupt and UART_RxInterrupt).
+ * @param tx    UART_TX_INT_EACH_BYTE (default) or UART_TX_INT_BUFFER_EMPTY
+ * @param rx    UART_RX_INT_EACH_BYTE (default) or UART_RX_INT_3_4_FULL. With the latter, UART2_onRxTimeout must be called periodically.
+ */
+#define UART2_setInterruptThresholds(tx, rx) UART_setInterruptThresholds(&UART2_instance, (tx), (rx))
+
+/**
+ * Receive timeout: read the last bytes of a message, that do not reach the receive interrupt threshold (or, with UART2_initRxDMA, the DMA half). Call it from a timer interrupt, every few characters times.
+ * @return      number of bytes moved to the receive buffer
+ */
+#define UART2_onRxTimeout() UART_onRxTimeout(&UART2_instance)
 
 /**
  * Adds a byte to the transmit buffer. It will be sent as soon as possible, but after the bytes already present in the buffer.
@@ -51,7 +97,7 @@ UART_Error UART2_init(U8 txPin, U16 txBufferSize, U8 txIntPriority, U8 rxPin, U1
  * @return      UART_OK if the operation was successfull.
  * @warning     Due to buffering, real transmission may be delayed.
  */
-UART_Error UART2_sendByte(S8 b);
+#define UART2_sendByte(b) UART_sendByte(&UART2_instance, (b))
 
 
 /**
@@ -61,7 +107,7 @@ UART_Error UART2_sendByte(S8 b);
  * @return      UART_BUFFER_OVERFLOW if the transmit buffer didn't have enought space for the array. In this case, nothing is written in the buffer (you can try again later, without having to manage a partial transmit).
  * @return      UART_OK if the operation was successfull.
  */
-UART_Error UART2_sendTab(const void * tab, U16 size);
+#define UART2_sendTab(tab, size) UART_sendTab(&UART2_instance, (tab), (size))
 
 /**
  * Adds an character string to the transmit buffer. Data will be sent as soon as possible, but after the bytes already present in the buffer. Order is preserved.
@@ -71,38 +117,96 @@ UART_Error UART2_sendTab(const void * tab, U16 size);
  * @warning     The final 0 of the string is not transmitted.
  * @warning     no security is provided against infinite string. You have to make sure it never happends.
  */
-UART_Error UART2_sendStr(const char * str);
+#define UART2_sendStr(str) UART_sendStr(&UART2_instance, (str))
+
+/**
+ * Adds several arrays to the transmit buffer, as a single message (e.g. header, payload and CRC). Data will be sent as soon as possible, but after the bytes already present in the buffer. Order is preserved.
+ * The message is written under a single interrupt protection: it can't be interleaved with bytes sent by an other part of the code, and there is no need to assemble it in a temporary buffer.
+ * @param segments  arrays to send, in order
+ * @param nb        number of arrays
+ * @return      UART_BUFFER_OVERFLOW if the transmit buffer didn't have enought space for the whole message. In this case, nothing is written in the buffer (you can try again later, without having to manage a partial transmit).
+ * @return      UART_OK if the operation was successfull.
+ */
+#define UART2_sendVector(segments, nb) UART_sendVector(&UART2_instance, (segments), (nb))
+
+/**
+ * Adds formatted text to the transmit buffer, as printf, for integers and floats with a fixed number of decimals (see Format_print for the conversions supported).
+ * The text is written directly in the transmit buffer: it is much faster than UART2_printf (no sprintf, no float library), and is not limited to 255 characters.
+ * @param   format and arguments, as printf
+ * @return      UART_BUFFER_OVERFLOW if the transmit buffer didn't have enought space for the whole text. In this case, nothing is written in the buffer (you can try again later, without having to manage a partial transmit).
+ * @return      UART_OK if the operation was successfull.
+ */
+#define UART2_sendFormat(...) UART_sendFormat(&UART2_instance, __VA_ARGS__)
+
+
+/**
+ * Send a frame (COBS encoded, with a CRC16, see Framer.c), made of several arrays. The frame is encoded directly in the transmit buffer, as a single message.
+ * @param framer    framer encoding the frame (only its statistics are modified, it can be the one used for reception)
+ * @param segments  parts of the payload, in order
+ * @param nb        number of parts
+ * @return      UART_BUFFER_OVERFLOW if the transmit buffer didn't have enought space for the encoded frame. In this case, nothing is written in the buffer.
+ * @return      UART_OK if the operation was successfull.
+ */
+#define UART2_sendFrame(framer, segments, nb) UART_sendFrame(&UART2_instance, (framer), (segments), (nb))
 
+/**
+ * Decode the bytes of the receive buffer with a framer. The valid frames are written in its output ObjectFIFO, as Framer_Frame (read them with ObjectFIFO_borrow/ObjectFIFO_release).
+ * The bytes are decoded in the receive buffer, without copy, and the receive interrupt is only blocked to read and update its pointers.
+ * @param framer    framer decoding the frames
+ * @return      number of frames written in the output ObjectFIFO
+ */
+#define UART2_receiveFrames(framer) UART_receiveFrames(&UART2_instance, (framer))
 
 /**
  * Get the number of bytes available in the receive buffer.
  * @return      Number of bytes available
  */
-U16 UART2_getRxBufferDataSize(void);
+#define UART2_getRxBufferDataSize() UART_getRxBufferDataSize(&UART2_instance)
 
 /**
  * Read a single byte from the receive buffer
  * @return      byte read. Undefeined if the buffer was empty.
  * @warning     The only way to make sure the value returned is valid is to check beforhand if there was some data to read. Use UART2_getRxBufferDataSize before you use UART2_readByte
  */
-S8 UART2_readByte(void);
+#define UART2_readByte() UART_readByte(&UART2_instance)
 
 /**
  * Read a serie of bytes from the receive buffer
  * @param tab   place you want the read data to be written.
  * @param size  number of bytes to read
- * @return      UART_ERROR_NOTENOUGHTDATA if the buffer did not contain at least as much data as you asked for. In this case no data is read.
+ * @return      UART_NOT_ENOUGHT_DATA if the buffer did not contain at least as much data as you asked for. In this case no data is read.
  * @return      UART_OK if the operation was successfull.
  *
  */
-S8 UART2_readTab(void*, U16);
+#define UART2_readTab(tab, size) UART_readTab(&UART2_instance, (tab), (size))
+
+/**
+ * Read all the bytes available in the receive buffer, up to size.
+ * @param tab   place you want the read data to be written.
+ * @param size  maximum number of bytes to read (size of tab)
+ * @return      number of bytes actually read.
+ * @remark      The whole read is done under a single interrupt protection, which makes it much cheaper than a loop on UART2_readByte.
+ */
+#define UART2_readAvailable(tab, size) UART_readAvailable(&UART2_instance, (tab), (size))
 
 /**
  * Function in charge of the transmit buffer managment. It must be called in the _U2TXInterrupt ISR. You can either do this using the macro UART2_setU2TXInterruptForMe, or by customizing the ISR.
  * Cutomizing is not advised as this ISR probably has a quite high priority, and should be kept as simple as possible. Do it carfully.
  * For maximum efficiency, make sure this ISR can be executed often enought to avoid pauses in data transmission (hardware module has a 4 bytes buffer)
  */
-void UART2_onU2TXInterrupt(void);
+#define UART2_onU2TXInterrupt() UART_onTxInterrupt(&UART2_instance)
+
+/**
+ * Function in charge of the transmit buffer managment when UART2_initTxDMA has been used. It must be called in the _DMAxInterrupt ISR of the channel, after its flag is cleared. You can do this using the macro UART2_setTxDMAInterruptForMe.
+ * It removes the part sent from the buffer, and gives the next one to the DMA.
+ */
+#define UART2_onTxDMAInterrupt() UART_onTxDMAInterrupt(&UART2_instance)
+
+/**
+ * Function in charge of the receive buffer managment when UART2_initRxDMA has been used. It must be called in the _DMAxInterrupt ISR of the channel, after its flag is cleared. You can do this using the macro UART2_setRxDMAInterruptForMe.
+ * It hands the half just filled over to the consumer or to the receive buffer.
+ */
+#define UART2_onRxDMAInterrupt() UART_onRxDMAInterrupt(&UART2_instance)
 
 /**
  * Fonction qui gère la partie buffering du module s'il est activé. Il faut l'executer depuis l'interrption _U2RXInterrupt, mais seulement si le buffering est activé (sinon on est à peu près certain de cracher le dsPIC).
@@ -114,10 +218,29 @@ void UART2_onU2TXInterrupt(void);
  * Function in charge of the receive buffer managment. It must be called in the _U2RXInterrupt ISR. You can either do this using the macro UART2_setU2RXInterruptForMe, or by customizing the ISR.
  * Typical customization will be buffer overflow managment, or direct management or received data.
  * Make sure the ISR can de executed often enought to avoid a buffer overflow in the hardware module (4 bytes buffer).
- * @return UART_ERROR_BUFFERALMOSTFULL if the received buffer was full. This means one byte of data has been lost. Quickly make some space to avoid losing every incoming bytes.
- * @return UART_OK if the received byte has been written in the buffer without any problem.
+ * All the bytes waiting in the hardware buffer are read in a single burst, and written in the receive buffer at once.
+ * A hardware overrun (OERR) is cleared, so that the module keeps receiving. The bytes with a framing or parity error are dropped. These errors are reported by UART2_getRxErrors.
+ * @return UART_BUFFER_OVERFLOW if the received buffer was full. This means data has been lost. Quickly make some space to avoid losing every incoming bytes.
+ * @return UART_OK if the received bytes have been written in the buffer without any problem.
+ */
+#define UART2_onU2RXInterrupt() UART_onRxInterrupt(&UART2_instance)
+
+/**
+ * Get the reception errors of UART2 since the last call, and clear them.
+ * @return  combination of UART_RxError flags (UART_RX_ERR_OVERRUN, UART_RX_ERR_FRAMING, UART_RX_ERR_PARITY, UART_RX_ERR_OVERFLOW), 0 if none
+ */
+#define UART2_getRxErrors() UART_getRxErrors(&UART2_instance)
+
+/**
+ * Get the statistics of UART2 (bytes sent and received, losses, buffers high-water marks), see UART_Stats.
+ * @param stats     where the statistics are copied
  */
-UART_Error UART2_onU2RXInterrupt(void);
+#define UART2_getStats(stats) UART_getStats(&UART2_instance, (stats))
+
+/**
+ * Reset the statistics of UART2 to 0.
+ */
+#define UART2_resetStats() UART_resetStats(&UART2_instance)
 
 /**
  * This macro sets an basic _U2TXInterrupt ISR managing transmit buffer
@@ -126,6 +249,22 @@ UART_Error UART2_onU2RXInterrupt(void);
  */
 #define UART2_setU2TXInterruptForMe(); void __attribute__((interrupt,no_auto_psv))_U2TXInterrupt(void)     {        UART2_onU2TXInterrupt();    }
 
+/**
+ * This macro sets the _DMAxInterrupt ISR of the channel given to UART2_initTxDMA
+ * @param channel   DMA channel (a literal number, 0 to 7)
+ * @warning Do not use several times in the same project, nor together with a custom ISR for this channel
+ * @warning Use outside of any function.
+ */
+#define UART2_setTxDMAInterruptForMe(channel); void __attribute__((interrupt,no_auto_psv))_DMA##channel##Interrupt(void)     {        _DMA##channel##IF = 0;        UART2_onTxDMAInterrupt();    }
+
+/**
+ * This macro sets the _DMAxInterrupt ISR of the channel given to UART2_initRxDMA
+ * @param channel   DMA channel (a literal number, 0 to 7)
+ * @warning Do not use several times in the same project, nor together with a custom ISR for this channel
+ * @warning Use outside of any function.
+ */
+#define UART2_setRxDMAInterruptForMe(channel); void __attribute__((interrupt,no_auto_psv))_DMA##channel##Interrupt(void)     {        _DMA##channel##IF = 0;        UART2_onRxDMAInterrupt();    }
+
 /**
  * This macro sets an basic _U2RXInterrupt ISR managing receive buffer
  * @warning Do not use several times in the same project, nor together with a custom ISR (you wont get very far, it will not compile)
@@ -137,6 +276,7 @@ UART_Error UART2_onU2RXInterrupt(void);
  * Send data to UART2 just as if UART2 was your screen and you use printf. Usefull for debugging.
  * @param   same as good old printf
  * @warning if the transmit buffer can't contain the produced string, no data is sent.
+ * @remark  UART2_sendFormat does the same for integers and %.nf floats, without sprintf.
  */
 #define UART2_printf(...); {char __msg__[255]; sprintf(__msg__,__VA_ARGS__); UART2_sendStr(__msg__);}
 
@@ -147,6 +287,6 @@ UART_Error UART2_onU2RXInterrupt(void);
  * @warning the waiting time can be quite long, compared to basic function.
  * @warning if the produced string is bigger than the transmit buffer, this is an infinite loop. Use carefully.
  */
-#define UART2_printfBlock(...) {char __msg__[255]; sprintf(__msg__,__VA_ARGS__); while(UART2_sendStr(__msg__)==UART_ERROR_BUFFEROVERFLOW); }
+#define UART2_printfBlock(...) {char __msg__[255]; sprintf(__msg__,__VA_ARGS__); while(UART2_sendStr(__msg__)==UART_BUFFER_OVERFLOW); }
 
 #endif //UART2_H
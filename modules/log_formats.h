@@ -0,0 +1,17 @@
+/*
+ * Format table of the deferred logger (Log.h). Each line declares a message:
+ *      LOG_FORMAT(name, "printf format")
+ * name becomes the id given to LOG (an enum value, in the order of the lines, 256 messages at most), the format is only used by the decoder (tools/logdecode.c), which includes this same file.
+ * Only the id and the arguments are sent: change the table, and both sides must be rebuilt.
+ * Conversions: %d %i %u %x %X %o %c (integers, up to 32 bits) and %f %F %e %E %g %G (float), with flags, width and precision. Length modifiers (h, l...) are accepted and ignored. No %s, %p nor %n.
+ *
+ * This is the default table, with the messages of the library. Give your own with -DLOG_FORMATS="\"myformats.h\"" (it can include this one).
+ */
+LOG_FORMAT(LOG_BOOT,        "boot")
+LOG_FORMAT(LOG_UART_STATS,  "UART%u: tx %lu, rx %lu, rx overflows %lu, overruns %lu, rx errors %lu")
+LOG_FORMAT(LOG_VECT,        "[%.2f,%.2f,%.2f]")
+LOG_FORMAT(LOG_QUAT,        "[%.2f,%.2f,%.2f,%.2f]")
+LOG_FORMAT(LOG_MATRIX33,    "[%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f]")
+LOG_FORMAT(LOG_MATRIX43,    "[%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f ; %.2f,%.2f,%.2f]")
+LOG_FORMAT(LOG_MATRIX34,    "[%.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f]")
+LOG_FORMAT(LOG_MATRIX44,    "[%.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f]")
@@ -0,0 +1,678 @@
+/** @file       dsPICsim.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host model of the dsPIC33FJ64MC802 peripherals. See dsPICsim.h.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dsPICsim.h"
+
+U16 sim_memory[SIM_MEMORY_SIZE / 2];
+
+#define MEM16(addr)         (*(volatile U16*)SIM_ADDR(addr))
+#define MEM8(addr)          (*(volatile U8*)SIM_ADDR(addr))
+
+// UxMODE bits
+#define MODE_STSEL          0x0001
+#define MODE_PDSEL          0x0006
+#define MODE_BRGH           0x0008
+#define MODE_UARTEN         0x8000
+// UxSTA bits
+#define STA_URXDA           0x0001
+#define STA_OERR            0x0002
+#define STA_FERR            0x0004
+#define STA_RIDLE           0x0010
+#define STA_URXISEL         0x00C0
+#define STA_TRMT            0x0100
+#define STA_UTXBF           0x0200
+#define STA_UTXEN           0x0400
+#define STA_UTXISEL0        0x2000
+#define STA_UTXISEL1        0x8000
+#define STA_STATUS          (STA_URXDA | STA_OERR | STA_FERR | STA_RIDLE | STA_TRMT | STA_UTXBF)
+// DMAxCON bits
+#define CON_MODE_ONESHOT    0x0001
+#define CON_MODE_PINGPONG   0x0002
+#define CON_AMODE           0x0030
+#define CON_HALF            0x1000
+#define CON_DIR             0x2000  // set: read from DMA RAM, write to peripheral
+#define CON_SIZE            0x4000  // set: byte
+#define CON_CHEN            0x8000
+// DMAxREQ bits
+#define REQ_IRQSEL          0x007F
+#define REQ_FORCE           0x8000
+
+#define DMA_BASE            0x0380
+#define DMA_CHANNEL_NB      8
+#define UART_FIFO_SIZE      4
+#define ERR_FRAME           0x8000  // flag of a received character, in the line and in the receive FIFO
+
+/// Where the interrupt controller keeps the flag, enable and priority of a source
+typedef struct {
+    U16 ifs;
+    U8 bit;
+    U16 ipc;
+    U8 ipShift;
+    void (*isr)(void);
+} Vector;
+
+static const Vector vectors[SIM_VECTOR_NB] = {
+    {0x0084,  4, 0x00A6, 0,  _DMA0Interrupt},
+    {0x0084, 11, 0x00A8, 12, _U1RXInterrupt},
+    {0x0084, 12, 0x00AA, 0,  _U1TXInterrupt},
+    {0x0084, 14, 0x00AA, 4,  _DMA1Interrupt},
+    {0x0086,  8, 0x00B0, 0,  _DMA2Interrupt},
+    {0x0086, 14, 0x00B2, 8,  _U2RXInterrupt},
+    {0x0086, 15, 0x00B2, 12, _U2TXInterrupt},
+    {0x0088,  4, 0x00B6, 0,  _DMA3Interrupt},
+    {0x0088, 14, 0x00BA, 4,  _DMA4Interrupt},
+    {0x008A, 13, 0x00C2, 4,  _DMA5Interrupt},
+    {0x008C,  1, 0x00C4, 4,  _U1ErrInterrupt},
+    {0x008C,  2, 0x00C4, 8,  _U2ErrInterrupt},
+    {0x008C,  4, 0x00C6, 0,  _DMA6Interrupt},
+    {0x008C,  5, 0x00C6, 4,  _DMA7Interrupt},
+};
+
+static const SIM_Vector dmaVectors[DMA_CHANNEL_NB] = {SIM_DMA0, SIM_DMA1, SIM_DMA2, SIM_DMA3, SIM_DMA4, SIM_DMA5, SIM_DMA6, SIM_DMA7};
+
+typedef struct {
+    U16 base;                   // address of UxMODE
+    SIM_Vector rxVector, txVector, errVector;
+    U8 rxIrq, txIrq;            // DMA request numbers (IRQSEL)
+
+    U16 txFifo[UART_FIFO_SIZE];
+    U8 txHead, txNb;
+    U8 tsrBusy;
+    U16 tsr;
+    uint64_t tsrEnd;            // when the character in the TSR will be completely sent
+    U8 txEnabled;
+
+    U16 rxFifo[UART_FIFO_SIZE];
+    U8 rxHead, rxNb;
+    U8 oerr;
+    U8 oerrShown;               // OERR has been set in UxSTA, the software can clear it
+    U32 lost;
+
+    U16* line;                  // characters to receive (with ERR_FRAME)
+    U32 lineRead, lineSize, lineCapacity;
+    uint64_t rxNext;            // when line[lineRead] will be completely received
+
+    U8* out;                    // characters sent
+    U32 outRead, outSize, outCapacity;
+} Uart;
+
+typedef struct {
+    U16 count;                  // transfers done in the current block
+    U8 half;                    // ping-pong: 0 for STA, 1 for STB
+    U8 enabled;
+    U32 transfers;
+} DmaChannel;
+
+static Uart uarts[2] = {
+    {.base = 0x0220, .rxVector = SIM_U1RX, .txVector = SIM_U1TX, .errVector = SIM_U1E, .rxIrq = 0x0B, .txIrq = 0x0C},
+    {.base = 0x0230, .rxVector = SIM_U2RX, .txVector = SIM_U2TX, .errVector = SIM_U2E, .rxIrq = 0x1E, .txIrq = 0x1F},
+};
+static DmaChannel dma[DMA_CHANNEL_NB];
+static uint64_t now;
+static U32 isrCount[SIM_VECTOR_NB];
+static volatile U16 txOverflow;    // written when UxTXREG is written while UTXBF is set
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Default ISR                                                                                                       */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+void __attribute__((weak)) _DMA0Interrupt(void)  { _DMA0IF = 0; }
+void __attribute__((weak)) _U1RXInterrupt(void)  { _U1RXIF = 0; }
+void __attribute__((weak)) _U1TXInterrupt(void)  { _U1TXIF = 0; }
+void __attribute__((weak)) _DMA1Interrupt(void)  { _DMA1IF = 0; }
+void __attribute__((weak)) _DMA2Interrupt(void)  { _DMA2IF = 0; }
+void __attribute__((weak)) _U2RXInterrupt(void)  { _U2RXIF = 0; }
+void __attribute__((weak)) _U2TXInterrupt(void)  { _U2TXIF = 0; }
+void __attribute__((weak)) _DMA3Interrupt(void)  { _DMA3IF = 0; }
+void __attribute__((weak)) _DMA4Interrupt(void)  { _DMA4IF = 0; }
+void __attribute__((weak)) _DMA5Interrupt(void)  { _DMA5IF = 0; }
+void __attribute__((weak)) _U1ErrInterrupt(void) { _U1EIF = 0; }
+void __attribute__((weak)) _U2ErrInterrupt(void) { _U2EIF = 0; }
+void __attribute__((weak)) _DMA6Interrupt(void)  { _DMA6IF = 0; }
+void __attribute__((weak)) _DMA7Interrupt(void)  { _DMA7IF = 0; }
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Interrupt controller                                                                                              */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+static void setFlag(const SIM_Vector v) {
+    MEM16(vectors[v].ifs) |= 1 << vectors[v].bit;
+}
+
+static U8 isPending(const SIM_Vector v) {
+    return (MEM16(vectors[v].ifs) >> vectors[v].bit) & 1
+        && (MEM16(vectors[v].ifs + 0x10) >> vectors[v].bit) & 1;
+}
+
+static U8 getPriority(const SIM_Vector v) {
+    return (MEM16(vectors[v].ipc) >> vectors[v].ipShift) & 7;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  DMA                                                                                                               */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+static void uartPush(Uart* u, const U16 value);
+static U16 uartPop(Uart* u);
+
+#define CH_CON(ch)  MEM16(DMA_BASE + 12 * (ch))
+#define CH_REQ(ch)  MEM16(DMA_BASE + 12 * (ch) + 2)
+#define CH_STA(ch)  MEM16(DMA_BASE + 12 * (ch) + 4)
+#define CH_STB(ch)  MEM16(DMA_BASE + 12 * (ch) + 6)
+#define CH_PAD(ch)  MEM16(DMA_BASE + 12 * (ch) + 8)
+#define CH_CNT(ch)  (MEM16(DMA_BASE + 12 * (ch) + 10) & 0x03FF)
+
+static U16 peripheralRead(const U16 addr, const U8 byte) {
+    U8 i;
+    for(i = 0; i < 2; i++) {
+        if(addr == uarts[i].base + 6) {     // UxRXREG
+            return uartPop(&uarts[i]);
+        }
+    }
+    return byte ? MEM8(addr) : MEM16(addr);
+}
+
+static void peripheralWrite(const U16 addr, const U16 value, const U8 byte) {
+    U8 i;
+    for(i = 0; i < 2; i++) {
+        if(addr == uarts[i].base + 4) {     // UxTXREG
+            uartPush(&uarts[i], byte ? value & 0xFF : value);
+            return;
+        }
+    }
+    if(byte) {
+        MEM8(addr) = value;
+    } else {
+        MEM16(addr) = value;
+    }
+}
+
+static void dmaTransfer(const U8 ch) {
+    DmaChannel* c = &dma[ch];
+    U16 con = CH_CON(ch);
+    U8 byte = (con & CON_SIZE) != 0;
+    U16 blockSize = CH_CNT(ch) + 1;
+    U16 addr = SIM_DMA_RAM_ADDR + (c->half ? CH_STB(ch) : CH_STA(ch));
+
+    if((con & CON_AMODE) == 0) {    // register indirect with post-increment
+        addr += c->count << (byte ? 0 : 1);
+    }
+    if(addr < SIM_DMA_RAM_ADDR || addr + (byte ? 1 : 2) > SIM_DMA_RAM_ADDR + SIM_DMA_RAM_SIZE) {
+        fprintf(stderr, "dsPICsim: DMA channel %d accesses 0x%04X, outside of the DMA RAM\n", ch, addr);
+        abort();
+    }
+
+    if(con & CON_DIR) {
+        peripheralWrite(CH_PAD(ch), byte ? MEM8(addr) : MEM16(addr), byte);
+    } else {
+        U16 value = peripheralRead(CH_PAD(ch), byte);
+        if(byte) {
+            MEM8(addr) = value;
+        } else {
+            MEM16(addr) = value;
+        }
+    }
+    DSADR = addr;
+    DMACS1 = (DMACS1 & 0xF0FF) | (ch << 8);     // LSTCH
+    c->transfers++;
+
+    if(++c->count == blockSize / 2 && (con & CON_HALF)) {
+        setFlag(dmaVectors[ch]);
+    }
+    if(c->count == blockSize) {
+        c->count = 0;
+        if(!(con & CON_HALF)) {
+            setFlag(dmaVectors[ch]);
+        }
+        if(con & CON_MODE_PINGPONG) {
+            c->half ^= 1;
+            DMACS1 ^= 1 << ch;                  // PPST
+        }
+        if((con & CON_MODE_ONESHOT) && !((con & CON_MODE_PINGPONG) && c->half)) {
+            CH_CON(ch) &= ~CON_CHEN;
+            c->enabled = 0;
+        }
+    }
+}
+
+/**
+ * Transfer one element on every enabled channel waiting for this request.
+ */
+static void dmaRequest(const U8 irq) {
+    U8 ch;
+    for(ch = 0; ch < DMA_CHANNEL_NB; ch++) {
+        if(dma[ch].enabled && (CH_REQ(ch) & REQ_IRQSEL) == irq) {
+            dmaTransfer(ch);
+        }
+    }
+}
+
+/**
+ * Follow CHEN and FORCE written by the software.
+ */
+static U8 dmaUpdate(void) {
+    U8 changed = 0;
+    U8 ch;
+    for(ch = 0; ch < DMA_CHANNEL_NB; ch++) {
+        U8 enabled = (CH_CON(ch) & CON_CHEN) != 0;
+        if(enabled && !dma[ch].enabled) {
+            dma[ch].count = 0;
+            dma[ch].half = 0;
+            DMACS1 &= ~(1 << ch);
+        }
+        dma[ch].enabled = enabled;
+        if(CH_REQ(ch) & REQ_FORCE) {
+            CH_REQ(ch) &= ~REQ_FORCE;
+            if(enabled) {
+                dmaTransfer(ch);
+                changed = 1;
+            }
+        }
+    }
+    return changed;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  UART                                                                                                              */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+static Uart* getUart(const U8 uart) {
+    if(uart != 1 && uart != 2) {
+        fprintf(stderr, "dsPICsim: there is no UART%d\n", uart);
+        abort();
+    }
+    return &uarts[uart - 1];
+}
+
+static U32 charCycles(const Uart* u) {
+    U16 mode = MEM16(u->base);
+    U16 pdsel = (mode & MODE_PDSEL) >> 1;
+    U32 bits = 1 + (pdsel == 3 ? 9 : 8) + (pdsel == 1 || pdsel == 2 ? 1 : 0) + (mode & MODE_STSEL ? 2 : 1);
+    return bits * (mode & MODE_BRGH ? 4 : 16) * ((U32)MEM16(u->base + 8) + 1);
+}
+
+static void txEvent(Uart* u) {
+    setFlag(u->txVector);
+    dmaRequest(u->txIrq);
+}
+
+static void rxEvent(Uart* u) {
+    setFlag(u->rxVector);
+    dmaRequest(u->rxIrq);
+}
+
+static void updateStatus(Uart* u) {
+    U16 sta = MEM16(u->base + 2) & ~STA_STATUS;
+    if(u->rxNb != 0) {
+        sta |= STA_URXDA;
+        if(u->rxFifo[u->rxHead] & ERR_FRAME) {
+            sta |= STA_FERR;
+        }
+    }
+    if(u->oerr) {
+        sta |= STA_OERR;
+    }
+    u->oerrShown = u->oerr;
+    if(u->lineRead == u->lineSize) {
+        sta |= STA_RIDLE;
+    }
+    if(!u->tsrBusy && u->txNb == 0) {
+        sta |= STA_TRMT;
+    }
+    if(u->txNb == UART_FIFO_SIZE) {
+        sta |= STA_UTXBF;
+    }
+    MEM16(u->base + 2) = sta;
+}
+
+/**
+ * Follow the configuration written by the software, and load the TSR if it is free.
+ * @return true if something changed
+ */
+static U8 uartUpdate(Uart* u) {
+    U16 mode = MEM16(u->base);
+    U16 sta = MEM16(u->base + 2);
+    U8 changed = 0;
+    U8 enabled = (mode & MODE_UARTEN) && (sta & STA_UTXEN);
+
+    if(!(mode & MODE_UARTEN)) {     // the buffers are reset when the module is off
+        u->txNb = 0;
+        u->rxNb = 0;
+        u->oerr = 0;
+        u->tsrBusy = 0;
+    }
+    if(u->oerrShown && !(sta & STA_OERR)) { // OERR cleared by the software: the receive FIFO is reset
+        u->oerr = 0;
+        u->oerrShown = 0;
+        u->rxNb = 0;
+    }
+    if(enabled && !u->txEnabled) {  // enabling the transmitter generates a transmit interrupt
+        u->txEnabled = 1;
+        txEvent(u);
+        changed = 1;
+    }
+    u->txEnabled = enabled;
+
+    if(enabled && !u->tsrBusy && u->txNb != 0) {
+        U8 isel = ((sta & STA_UTXISEL1) ? 2 : 0) | ((sta & STA_UTXISEL0) ? 1 : 0);
+        u->tsr = u->txFifo[u->txHead];
+        u->txHead = (u->txHead + 1) % UART_FIFO_SIZE;
+        u->txNb--;
+        u->tsrBusy = 1;
+        u->tsrEnd = now + charCycles(u);
+        if(isel == 0 || (isel == 2 && u->txNb == 0)) {
+            txEvent(u);
+        }
+        changed = 1;
+    }
+    updateStatus(u);
+    return changed;
+}
+
+static void uartPush(Uart* u, const U16 value) {
+    if(u->txNb == UART_FIFO_SIZE) {
+        return;
+    }
+    u->txFifo[(u->txHead + u->txNb) % UART_FIFO_SIZE] = value;
+    u->txNb++;
+}
+
+static U16 uartPop(Uart* u) {
+    U16 ret = 0;
+    if(u->rxNb != 0) {
+        ret = u->rxFifo[u->rxHead] & 0x01FF;
+        u->rxHead = (u->rxHead + 1) % UART_FIFO_SIZE;
+        u->rxNb--;
+    }
+    updateStatus(u);
+    return ret;
+}
+
+static void txDone(Uart* u) {
+    U16 sta = MEM16(u->base + 2);
+    if(u->outSize == u->outCapacity) {
+        u->outCapacity = u->outCapacity ? 2 * u->outCapacity : 256;
+        u->out = realloc(u->out, u->outCapacity);
+    }
+    u->out[u->outSize++] = (U8)u->tsr;
+    u->tsrBusy = 0;
+    if((sta & STA_UTXISEL0) && !(sta & STA_UTXISEL1) && u->txNb == 0) {  // interrupt when the transmission is complete
+        txEvent(u);
+    }
+}
+
+static void rxDone(Uart* u) {
+    U16 value = u->line[u->lineRead++];
+    U8 isel = (MEM16(u->base + 2) & STA_URXISEL) >> 6;
+
+    if(u->lineRead < u->lineSize) {
+        u->rxNext += charCycles(u);
+    }
+    if(!(MEM16(u->base) & MODE_UARTEN)) {
+        return;
+    }
+    if(u->oerr || u->rxNb == UART_FIFO_SIZE) {
+        u->oerr = 1;
+        u->lost++;
+        setFlag(u->errVector);
+        return;
+    }
+    u->rxFifo[(u->rxHead + u->rxNb) % UART_FIFO_SIZE] = value;
+    u->rxNb++;
+    if(value & ERR_FRAME) {
+        setFlag(u->errVector);
+    }
+    if(isel < 2 || (isel == 2 && u->rxNb == 3) || (isel == 3 && u->rxNb == UART_FIFO_SIZE)) {
+        rxEvent(u);
+    }
+}
+
+static void lineAppend(Uart* u, const U16 value) {
+    if(u->lineRead == u->lineSize) {    // idle line: start now
+        u->lineRead = 0;
+        u->lineSize = 0;
+        u->rxNext = now + charCycles(u);
+    }
+    if(u->lineSize == u->lineCapacity) {
+        u->lineCapacity = u->lineCapacity ? 2 * u->lineCapacity : 256;
+        u->line = realloc(u->line, u->lineCapacity * sizeof(U16));
+    }
+    u->line[u->lineSize++] = value;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Engine                                                                                                            */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Bring the peripherals up to date with what the software wrote, until nothing changes.
+ */
+static void settle(void) {
+    U8 changed;
+    do {
+        changed = dmaUpdate();
+        changed |= uartUpdate(&uarts[0]);
+        changed |= uartUpdate(&uarts[1]);
+    } while(changed);
+}
+
+void sim_checkInterrupts(void) {
+    U32 guard = 0;
+    for(;;) {
+        U8 ipl = SRbits.IPL;
+        U8 best = SIM_VECTOR_NB;
+        U8 bestPriority = ipl;
+        U8 v;
+
+        settle();
+        for(v = 0; v < SIM_VECTOR_NB; v++) {
+            if(isPending(v) && getPriority(v) > bestPriority) {
+                best = v;
+                bestPriority = getPriority(v);
+            }
+        }
+        if(best == SIM_VECTOR_NB) {
+            return;
+        }
+        if(++guard == 1000000) {
+            fprintf(stderr, "dsPICsim: the ISR of vector %d never clears its flag\n", best);
+            abort();
+        }
+        isrCount[best]++;
+        SRbits.IPL = bestPriority;
+        vectors[best].isr();
+        SRbits.IPL = ipl;
+    }
+}
+
+static uint64_t nextEvent(const uint64_t end) {
+    uint64_t ret = end;
+    U8 i;
+    for(i = 0; i < 2; i++) {
+        if(uarts[i].tsrBusy && uarts[i].tsrEnd < ret) {
+            ret = uarts[i].tsrEnd;
+        }
+        if(uarts[i].lineRead < uarts[i].lineSize && uarts[i].rxNext < ret) {
+            ret = uarts[i].rxNext;
+        }
+    }
+    return ret < now ? now : ret;
+}
+
+static void runEvents(void) {
+    U8 i;
+    for(i = 0; i < 2; i++) {
+        Uart* u = &uarts[i];
+        if(u->tsrBusy && u->tsrEnd <= now) {
+            txDone(u);
+        }
+        if(u->lineRead < u->lineSize && u->rxNext <= now) {
+            rxDone(u);
+        }
+    }
+}
+
+U8 sim_runUntil(U8 (*done)(void), const uint64_t maxCycles) {
+    uint64_t end = now + maxCycles;
+    sim_checkInterrupts();
+    for(;;) {
+        if(done != null && done()) {
+            return 1;
+        }
+        if(now == end) {
+            return 0;
+        }
+        now = nextEvent(end);
+        runEvents();
+        sim_checkInterrupts();
+    }
+}
+
+void sim_run(const uint64_t cycles) {
+    sim_runUntil(null, cycles);
+}
+
+uint64_t sim_getCycles(void) {
+    return now;
+}
+
+void sim_reset(void) {
+    U8 i;
+    memset(sim_memory, 0, sizeof(sim_memory));
+    for(i = 0; i < 18; i++) {
+        MEM16(0x00A4 + 2 * i) = 0x4444;     // IPCx: every priority at 4
+    }
+    for(i = 0; i < 2; i++) {
+        Uart* u = &uarts[i];
+        free(u->line);
+        free(u->out);
+        memset(&u->txFifo, 0, sizeof(*u) - offsetof(Uart, txFifo));
+        updateStatus(u);
+    }
+    memset(dma, 0, sizeof(dma));
+    TRISA = 0xFFFF;
+    TRISB = 0xFFFF;
+    OSCCON = 0x1120;    // FRC + PLL, PLL locked
+    CLKDIV = 0x3040;
+    PLLFBD = 0x0030;
+    now = 0;
+    sim_resetStats();
+}
+
+U32 sim_getFcy(void) {
+    static const U8 post[4] = {2, 4, 0, 8};
+    double frc = 7370000.0 * (1.0 + 0.00375 * (((S8)(OSCTUNbits.TUN << 2)) >> 2));
+    double fosc;
+    if(post[_PLLPOST] == 0) {
+        return 0;
+    }
+    fosc = frc / (_PLLPRE + 2) * (_PLLDIV + 2) / post[_PLLPOST];
+    return (U32)(fosc / 2);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Register accesses of the drivers                                                                                  */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+volatile U16* sim_uartWriteTXREG(U8 uart) {
+    Uart* u = getUart(uart);
+    volatile U16* ret = &txOverflow;
+    uartUpdate(u);          // the previous write is complete, it can go in the TSR
+    if(u->txNb != UART_FIFO_SIZE) {
+        ret = &u->txFifo[(u->txHead + u->txNb) % UART_FIFO_SIZE];
+        u->txNb++;
+    }
+    updateStatus(u);
+    return ret;
+}
+
+U16 sim_uartReadRXREG(U8 uart) {
+    return uartPop(getUart(uart));
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Other end of the lines                                                                                            */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+void sim_uartReceive(const U8 uart, const void* data, const U32 size) {
+    Uart* u = getUart(uart);
+    U32 i;
+    for(i = 0; i < size; i++) {
+        lineAppend(u, ((const U8*)data)[i]);
+    }
+    updateStatus(u);
+}
+
+void sim_uartReceiveBadFrame(const U8 uart, const U8 value) {
+    Uart* u = getUart(uart);
+    lineAppend(u, value | ERR_FRAME);
+    updateStatus(u);
+}
+
+U32 sim_uartGetPendingRx(const U8 uart) {
+    Uart* u = getUart(uart);
+    return u->lineSize - u->lineRead;
+}
+
+U32 sim_uartTransmitted(const U8 uart, void* data, const U32 maxSize) {
+    Uart* u = getUart(uart);
+    U32 ret = u->outSize - u->outRead;
+    if(ret > maxSize) {
+        ret = maxSize;
+    }
+    if(data != null) {
+        memcpy(data, u->out + u->outRead, ret);
+    }
+    u->outRead += ret;
+    if(u->outRead == u->outSize) {
+        u->outRead = 0;
+        u->outSize = 0;
+    }
+    return ret;
+}
+
+U32 sim_uartGetCharCycles(const U8 uart) {
+    return charCycles(getUart(uart));
+}
+
+U32 sim_uartGetLostNb(const U8 uart) {
+    return getUart(uart)->lost;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Statistics                                                                                                        */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+U32 sim_getIsrCount(const SIM_Vector vector) {
+    return isrCount[vector];
+}
+
+U32 sim_getIsrTotal(void) {
+    U32 ret = 0;
+    U8 v;
+    for(v = 0; v < SIM_VECTOR_NB; v++) {
+        ret += isrCount[v];
+    }
+    return ret;
+}
+
+U32 sim_getDmaTransferCount(const U8 channel) {
+    return dma[channel].transfers;
+}
+
+void sim_resetStats(void) {
+    U8 i;
+    memset(isrCount, 0, sizeof(isrCount));
+    for(i = 0; i < DMA_CHANNEL_NB; i++) {
+        dma[i].transfers = 0;
+    }
+}
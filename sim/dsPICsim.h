@@ -0,0 +1,170 @@
+/** @file       dsPICsim.h
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host model of the dsPIC33FJ64MC802 peripherals used by the library (UART1/2, DMA, interrupt controller, oscillator),
+ *  so that the drivers of modules/ can be compiled unchanged, run, tested and profiled on a Linux host.
+ *
+ *  The drivers include <p33Fxxxx.h>: with the sim directory first in the include path, they get sim/p33Fxxxx.h, whose SFR live in sim_memory.
+ *      gcc -std=gnu99 -fgnu89-inline -Isim -I. mytest.c sim/dsPICsim.c modules/UART1.c algos/lists/ByteFIFO.c
+ *
+ *  Time is a virtual clock counting instruction cycles (Fcy). It only advances in sim_run: the code under test runs in zero time,
+ *  and the peripherals progress between the calls. Interrupts are dispatched by priority when the clock advances and when the CPU IPL is lowered
+ *  (RESTORE_CPU_IPL, so at the end of each INTERRUPT_PROTECT), which is where the real CPU would take them.
+ *
+ *  UART model: 4 levels transmit and receive FIFOs, transmit shift register, UTXISEL/URXISEL interrupt modes, URXDA/UTXBF/TRMT/RIDLE,
+ *  overrun (OERR, reception stops until OERR is cleared) and framing errors (FERR, U1EIF). A character takes (1 start + data + parity + stop) bits
+ *  of 4 (BRGH=1) or 16 (BRGH=0) * (UxBRG+1) cycles, so the baudrate is the one the driver configured.
+ *  The other end of the line is the test: sim_uartReceive queues characters that arrive one by one at the configured rate,
+ *  sim_uartTransmitted returns what the UART sent.
+ *
+ *  DMA model: the 8 channels of DMA_settings (modules/DMA.h), triggered by the UART interrupt events (IRQSEL) or FORCE.
+ *  Byte/word size, both directions, register indirect with or without post-increment, continuous/one-shot, ping-pong, HALF, DSADR, DMACS1 PPST bits.
+ *  Buffers have to be in the DMA RAM (0x4000-0x47FF, STA and STB are offsets from its beginning).
+ *
+ *  Oscillator: OSCCON.LOCK is always set, and sim_getFcy computes Fcy from the FRC, OSCTUN, CLKDIV and PLLFBD written by oscConfig.
+ *
+ *  ISR: _U1RXInterrupt, _U1TXInterrupt... are weak symbols that only clear their flag. Define them in the test (with the usual XC16 attributes) to handle the interrupts.
+ *  sim_getIsrCount and sim_getDmaTransferCount measure the CPU load of a driver: number of interrupts per byte, per frame...
+*/
+
+#ifndef DSPICSIM_H
+#define DSPICSIM_H
+
+#include <stdint.h>
+#include "p33Fxxxx.h"
+
+/// Interrupt sources of the model, in natural priority order (lowest vector first)
+typedef enum {
+    SIM_DMA0,
+    SIM_U1RX,
+    SIM_U1TX,
+    SIM_DMA1,
+    SIM_DMA2,
+    SIM_U2RX,
+    SIM_U2TX,
+    SIM_DMA3,
+    SIM_DMA4,
+    SIM_DMA5,
+    SIM_U1E,
+    SIM_U2E,
+    SIM_DMA6,
+    SIM_DMA7,
+    SIM_VECTOR_NB
+} SIM_Vector;
+
+/// DMA RAM of the dsPIC33FJ64MC802
+#define SIM_DMA_RAM_ADDR    0x4000
+#define SIM_DMA_RAM_SIZE    0x0800
+
+/**
+ * Put the model in its reset state: SFR at their reset values, empty UART FIFOs and lines, clock and statistics at 0.
+ */
+void sim_reset(void);
+
+/**
+ * Advance the virtual clock, running the peripherals and the interrupts.
+ * @param cycles    number of instruction cycles to run
+ */
+void sim_run(const uint64_t cycles);
+
+/**
+ * Advance the virtual clock until a condition is true.
+ * @param done      condition, checked after each peripheral event
+ * @param maxCycles maximum number of cycles to run
+ * @return          true if the condition became true, false on timeout
+ */
+U8 sim_runUntil(U8 (*done)(void), const uint64_t maxCycles);
+
+/**
+ * @return number of instruction cycles since sim_reset
+ */
+uint64_t sim_getCycles(void);
+
+/**
+ * Refresh the peripherals and execute the pending interrupts whose priority is above the CPU IPL.
+ * Called by RESTORE_CPU_IPL and sim_run, there is normally no need to call it directly.
+ */
+void sim_checkInterrupts(void);
+
+/**
+ * @return instruction frequency (Hz) given by the oscillator configuration (FRC + PLL)
+ */
+U32 sim_getFcy(void);
+
+/**
+ * Send characters to a UART: they arrive one by one, at the rate configured by the driver, after the ones already queued.
+ * @param uart  1 or 2
+ * @param data  characters
+ * @param size  number of characters
+ */
+void sim_uartReceive(const U8 uart, const void* data, const U32 size);
+
+/**
+ * Send a character with a framing error (missing stop bit) to a UART.
+ * @param uart  1 or 2
+ */
+void sim_uartReceiveBadFrame(const U8 uart, const U8 value);
+
+/**
+ * @param uart  1 or 2
+ * @return      number of characters queued by sim_uartReceive that have not arrived yet
+ */
+U32 sim_uartGetPendingRx(const U8 uart);
+
+/**
+ * Get the characters sent by a UART since the last call.
+ * @param uart      1 or 2
+ * @param data      where to copy the characters (can be null to drop them)
+ * @param maxSize   maximum number of characters to get
+ * @return          number of characters copied
+ */
+U32 sim_uartTransmitted(const U8 uart, void* data, const U32 maxSize);
+
+/**
+ * @param uart  1 or 2
+ * @return      duration of a character with the current configuration, in cycles
+ */
+U32 sim_uartGetCharCycles(const U8 uart);
+
+/**
+ * @param uart  1 or 2
+ * @return      number of characters lost because of an overrun since sim_reset
+ */
+U32 sim_uartGetLostNb(const U8 uart);
+
+/**
+ * @return number of times the ISR of a source has been executed since the last sim_resetStats
+ */
+U32 sim_getIsrCount(const SIM_Vector vector);
+
+/**
+ * @return number of ISR executed, all sources included, since the last sim_resetStats
+ */
+U32 sim_getIsrTotal(void);
+
+/**
+ * @param channel   0 to 7
+ * @return          number of DMA transfers done by a channel since the last sim_resetStats
+ */
+U32 sim_getDmaTransferCount(const U8 channel);
+
+void sim_resetStats(void);
+
+void _DMA0Interrupt(void);
+void _U1RXInterrupt(void);
+void _U1TXInterrupt(void);
+void _DMA1Interrupt(void);
+void _DMA2Interrupt(void);
+void _U2RXInterrupt(void);
+void _U2TXInterrupt(void);
+void _DMA3Interrupt(void);
+void _DMA4Interrupt(void);
+void _DMA5Interrupt(void);
+void _U1ErrInterrupt(void);
+void _U2ErrInterrupt(void);
+void _DMA6Interrupt(void);
+void _DMA7Interrupt(void);
+
+#endif // DSPICSIM_H
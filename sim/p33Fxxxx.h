@@ -0,0 +1,294 @@
+/** @file       p33Fxxxx.h
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host replacement of the XC16 device header, used by the dsPIC simulator (see dsPICsim.h).
+ *  Put the sim directory first in the include path (gcc -Isim ...) and <p33Fxxxx.h> resolves to this file:
+ *  the drivers are compiled unchanged, their SFR accesses go to a simulated memory and the peripherals are run by dsPICsim.c.
+ *
+ *  Only the registers and bits used by the library are described: UART1/2, DMA, interrupt controller, oscillator, PPS and ports A/B.
+ *  Addresses are the ones of the dsPIC33FJ64MC802.
+ *
+ *  UxTXREG and UxRXREG are not plain memory: writing UxTXREG pushes in the transmit FIFO of the model and reading UxRXREG pops its receive FIFO,
+ *  exactly as the hardware does. Status bits (URXDA, UTXBF, TRMT...) are refreshed by the model each time it runs.
+*/
+
+#ifndef SIM_P33FXXXX_H
+#define SIM_P33FXXXX_H
+
+#include "../typedef.h"
+
+/// Size of the simulated data space: SFR (0x0000-0x07FF), RAM (0x0800-0x3FFF) and DMA RAM (0x4000-0x47FF)
+#define SIM_MEMORY_SIZE     0x4800
+
+extern U16 sim_memory[SIM_MEMORY_SIZE / 2];
+
+/// Host address of a dsPIC data space address
+#define SIM_ADDR(addr)      ((void*)((U8*)sim_memory + (addr)))
+#define SIM_SFR(addr)       (*(volatile U16*)SIM_ADDR(addr))
+#define SIM_BITS(type, addr)    (*(volatile type*)SIM_ADDR(addr))
+
+volatile U16* sim_uartWriteTXREG(U8 uart);
+U16 sim_uartReadRXREG(U8 uart);
+void sim_checkInterrupts(void);
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Generic bit layouts                                                                                               */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    U16 b0:1; U16 b1:1; U16 b2:1; U16 b3:1; U16 b4:1; U16 b5:1; U16 b6:1; U16 b7:1;
+    U16 b8:1; U16 b9:1; U16 b10:1; U16 b11:1; U16 b12:1; U16 b13:1; U16 b14:1; U16 b15:1;
+} SIM_BITS16;
+
+/// Every IPCx register holds 4 priorities of 3 bits
+typedef struct {
+    U16 IP0:3; U16 :1;
+    U16 IP1:3; U16 :1;
+    U16 IP2:3; U16 :1;
+    U16 IP3:3; U16 :1;
+} SIM_IPCBITS;
+
+#define SIM_BIT(addr, n)    (SIM_BITS(SIM_BITS16, addr).b##n)
+#define SIM_IP(addr, n)     (SIM_BITS(SIM_IPCBITS, addr).IP##n)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  CPU                                                                                                               */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    U16 C:1; U16 Z:1; U16 OV:1; U16 N:1; U16 RA:1;
+    U16 IPL:3;
+    U16 DC:1; U16 DA:1; U16 SAB:1; U16 OAB:1; U16 SB:1; U16 SA:1; U16 OB:1; U16 OA:1;
+} SRBITS;
+
+#define SR          SIM_SFR(0x0042)
+#define SRbits      SIM_BITS(SRBITS, 0x0042)
+
+#define SET_CPU_IPL(ipl)                    do { SRbits.IPL = (ipl); sim_checkInterrupts(); } while(0)
+#define SET_AND_SAVE_CPU_IPL(save, ipl)     do { (save) = SRbits.IPL; SRbits.IPL = (ipl); } while(0)
+#define RESTORE_CPU_IPL(save)               SET_CPU_IPL(save)
+
+/// ISR attributes of XC16 mean nothing for the host compiler
+#define interrupt
+#define no_auto_psv
+#define auto_psv
+#define shadow
+
+#define Nop()       do {} while(0)
+#define ClrWdt()    do {} while(0)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Interrupt controller                                                                                              */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#define IFS0        SIM_SFR(0x0084)
+#define IFS1        SIM_SFR(0x0086)
+#define IFS2        SIM_SFR(0x0088)
+#define IFS3        SIM_SFR(0x008A)
+#define IFS4        SIM_SFR(0x008C)
+#define IEC0        SIM_SFR(0x0094)
+#define IEC1        SIM_SFR(0x0096)
+#define IEC2        SIM_SFR(0x0098)
+#define IEC3        SIM_SFR(0x009A)
+#define IEC4        SIM_SFR(0x009C)
+#define IPC0        SIM_SFR(0x00A4)     // IPCx is at 0x00A4 + 2*x
+
+#define _DMA0IF     SIM_BIT(0x0084, 4)
+#define _U1RXIF     SIM_BIT(0x0084, 11)
+#define _U1TXIF     SIM_BIT(0x0084, 12)
+#define _DMA1IF     SIM_BIT(0x0084, 14)
+#define _DMA2IF     SIM_BIT(0x0086, 8)
+#define _U2RXIF     SIM_BIT(0x0086, 14)
+#define _U2TXIF     SIM_BIT(0x0086, 15)
+#define _DMA3IF     SIM_BIT(0x0088, 4)
+#define _DMA4IF     SIM_BIT(0x0088, 14)
+#define _DMA5IF     SIM_BIT(0x008A, 13)
+#define _U1EIF      SIM_BIT(0x008C, 1)
+#define _U2EIF      SIM_BIT(0x008C, 2)
+#define _DMA6IF     SIM_BIT(0x008C, 4)
+#define _DMA7IF     SIM_BIT(0x008C, 5)
+
+#define _DMA0IE     SIM_BIT(0x0094, 4)
+#define _U1RXIE     SIM_BIT(0x0094, 11)
+#define _U1TXIE     SIM_BIT(0x0094, 12)
+#define _DMA1IE     SIM_BIT(0x0094, 14)
+#define _DMA2IE     SIM_BIT(0x0096, 8)
+#define _U2RXIE     SIM_BIT(0x0096, 14)
+#define _U2TXIE     SIM_BIT(0x0096, 15)
+#define _DMA3IE     SIM_BIT(0x0098, 4)
+#define _DMA4IE     SIM_BIT(0x0098, 14)
+#define _DMA5IE     SIM_BIT(0x009A, 13)
+#define _U1EIE      SIM_BIT(0x009C, 1)
+#define _U2EIE      SIM_BIT(0x009C, 2)
+#define _DMA6IE     SIM_BIT(0x009C, 4)
+#define _DMA7IE     SIM_BIT(0x009C, 5)
+
+#define _DMA0IP     SIM_IP(0x00A6, 0)   // IPC1
+#define _U1RXIP     SIM_IP(0x00A8, 3)   // IPC2
+#define _U1TXIP     SIM_IP(0x00AA, 0)   // IPC3
+#define _DMA1IP     SIM_IP(0x00AA, 1)   // IPC3
+#define _DMA2IP     SIM_IP(0x00B0, 0)   // IPC6
+#define _U2RXIP     SIM_IP(0x00B2, 2)   // IPC7
+#define _U2TXIP     SIM_IP(0x00B2, 3)   // IPC7
+#define _DMA3IP     SIM_IP(0x00B6, 0)   // IPC9
+#define _DMA4IP     SIM_IP(0x00BA, 1)   // IPC11
+#define _DMA5IP     SIM_IP(0x00C2, 1)   // IPC15
+#define _U1EIP      SIM_IP(0x00C4, 1)   // IPC16
+#define _U2EIP      SIM_IP(0x00C4, 2)   // IPC16
+#define _DMA6IP     SIM_IP(0x00C6, 0)   // IPC17
+#define _DMA7IP     SIM_IP(0x00C6, 1)   // IPC17
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  UART                                                                                                              */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    U16 STSEL:1;
+    U16 PDSEL:2;
+    U16 BRGH:1;
+    U16 URXINV:1;
+    U16 ABAUD:1;
+    U16 LPBACK:1;
+    U16 WAKE:1;
+    U16 UEN:2;
+    U16 :1;
+    U16 RTSMD:1;
+    U16 IREN:1;
+    U16 USIDL:1;
+    U16 :1;
+    U16 UARTEN:1;
+} UxMODEBITS;
+
+typedef struct {
+    U16 URXDA:1;
+    U16 OERR:1;
+    U16 FERR:1;
+    U16 PERR:1;
+    U16 RIDLE:1;
+    U16 ADDEN:1;
+    U16 URXISEL:2;
+    U16 TRMT:1;
+    U16 UTXBF:1;
+    U16 UTXEN:1;
+    U16 UTXBRK:1;
+    U16 :1;
+    U16 UTXISEL0:1;
+    U16 UTXINV:1;
+    U16 UTXISEL1:1;
+} UxSTABITS;
+
+#define U1MODE      SIM_SFR(0x0220)
+#define U1MODEbits  SIM_BITS(UxMODEBITS, 0x0220)
+#define U1STA       SIM_SFR(0x0222)
+#define U1STAbits   SIM_BITS(UxSTABITS, 0x0222)
+#define U1TXREG     (*sim_uartWriteTXREG(1))
+#define U1RXREG     (sim_uartReadRXREG(1))
+#define U1BRG       SIM_SFR(0x0228)
+
+#define U2MODE      SIM_SFR(0x0230)
+#define U2MODEbits  SIM_BITS(UxMODEBITS, 0x0230)
+#define U2STA       SIM_SFR(0x0232)
+#define U2STAbits   SIM_BITS(UxSTABITS, 0x0232)
+#define U2TXREG     (*sim_uartWriteTXREG(2))
+#define U2RXREG     (sim_uartReadRXREG(2))
+#define U2BRG       SIM_SFR(0x0238)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  DMA (channels are accessed through DMA_settings, see modules/DMA.h)                                               */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#define DMACS0      SIM_SFR(0x03E0)
+#define DMACS1      SIM_SFR(0x03E2)
+#define DSADR       SIM_SFR(0x03E4)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Oscillator                                                                                                        */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    U16 OSWEN:1;
+    U16 LPOSCEN:1;
+    U16 :1;
+    U16 CF:1;
+    U16 :1;
+    U16 LOCK:1;
+    U16 IOLOCK:1;
+    U16 CLKLOCK:1;
+    U16 NOSC:3;
+    U16 :1;
+    U16 COSC:3;
+    U16 :1;
+} OSCCONBITS;
+
+typedef struct {
+    U16 PLLPRE:5;
+    U16 :1;
+    U16 PLLPOST:2;
+    U16 FRCDIV:3;
+    U16 DOZEN:1;
+    U16 DOZE:3;
+    U16 ROI:1;
+} CLKDIVBITS;
+
+typedef struct {
+    U16 PLLDIV:9;
+    U16 :7;
+} PLLFBDBITS;
+
+typedef struct {
+    U16 TUN:6;
+    U16 :10;
+} OSCTUNBITS;
+
+#define OSCCON      SIM_SFR(0x0742)
+#define OSCCONbits  SIM_BITS(OSCCONBITS, 0x0742)
+#define CLKDIV      SIM_SFR(0x0744)
+#define CLKDIVbits  SIM_BITS(CLKDIVBITS, 0x0744)
+#define PLLFBD      SIM_SFR(0x0746)
+#define PLLFBDbits  SIM_BITS(PLLFBDBITS, 0x0746)
+#define OSCTUN      SIM_SFR(0x0748)
+#define OSCTUNbits  SIM_BITS(OSCTUNBITS, 0x0748)
+
+#define _PLLPRE     CLKDIVbits.PLLPRE
+#define _PLLPOST    CLKDIVbits.PLLPOST
+#define _FRCDIV     CLKDIVbits.FRCDIV
+#define _PLLDIV     PLLFBDbits.PLLDIV
+#define _TUN        OSCTUNbits.TUN
+
+/// Only the low byte of OSCCON is written, as the real builtin does
+#define __builtin_write_OSCCONL(value)  (OSCCON = (OSCCON & 0xFF00) | ((value) & 0x00FF))
+#define __builtin_write_OSCCONH(value)  (OSCCON = (OSCCON & 0x00FF) | (((value) & 0x00FF) << 8))
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Peripheral Pin Select (outputs are accessed through PPS_BASE_ADDR, see modules/PPinSelect.h)                      */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    U16 RXR:5;
+    U16 :3;
+    U16 CTSR:5;
+    U16 :3;
+} RPINRUBITS;
+
+#define RPINR18     SIM_SFR(0x06A4)
+#define RPINR19     SIM_SFR(0x06A6)
+#define _U1RXR      SIM_BITS(RPINRUBITS, 0x06A4).RXR
+#define _U1CTSR     SIM_BITS(RPINRUBITS, 0x06A4).CTSR
+#define _U2RXR      SIM_BITS(RPINRUBITS, 0x06A6).RXR
+#define _U2CTSR     SIM_BITS(RPINRUBITS, 0x06A6).CTSR
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/*  Ports                                                                                                             */
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#define TRISA       SIM_SFR(0x02C0)
+#define PORTA       SIM_SFR(0x02C2)
+#define LATA        SIM_SFR(0x02C4)
+#define TRISB       SIM_SFR(0x02C8)
+#define PORTB       SIM_SFR(0x02CA)
+#define LATB        SIM_SFR(0x02CC)
+#define AD1PCFGL    SIM_SFR(0x032C)
+
+#endif // SIM_P33FXXXX_H
@@ -0,0 +1,189 @@
+/** @file       logdecode.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host decoder of the deferred logger (modules/Log.h): reads the byte stream sent by the UART (a serial port, or a capture file), and prints the messages as text, one per line.
+ *  It decodes the frames with the library Framer, and formats them with the format table of the firmware (the same log_formats.h, or the one given with -DLOG_FORMATS).
+ *      gcc -O2 -std=gnu99 -fgnu89-inline -I. -Ialgos/lists -include stddef.h -o logdecode tools/logdecode.c algos/Framer.c algos/CRC.c algos/lists/ObjectFIFO.c algos/lists/ByteFIFO.c
+ *      stty -F /dev/ttyUSB0 115200 raw && ./logdecode < /dev/ttyUSB0
+ *  The damaged frames are skipped (the count is given at the end), the unknown ids and the records that do not match their format are printed raw.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "../typedef.h"
+#include "../algos/Framer.h"
+
+typedef struct {
+    const char* name;
+    const char* format;
+} Format;
+
+static const Format formats[] = {
+#define LOG_FORMAT(name, format) {#name, format},
+#ifdef LOG_FORMATS
+#include LOG_FORMATS
+#else
+#include "../modules/log_formats.h"
+#endif
+#undef LOG_FORMAT
+};
+#define FORMAT_NB   (sizeof(formats) / sizeof(formats[0]))
+
+/**
+ * Read a float argument of a record: its 32 bits, little endian (as written by the dsPIC).
+ * @return  false if the record ends before
+ */
+static U8 readFloat(const U8** p, const U8* end, U32* value) {
+    if(end - *p < 4) {
+        return 0;
+    }
+    *value = (U32)(*p)[0] | (U32)(*p)[1] << 8 | (U32)(*p)[2] << 16 | (U32)(*p)[3] << 24;
+    *p += 4;
+    return 1;
+}
+
+/**
+ * Read an integer argument of a record: a zigzag varint (see Log_write), 5 bytes at most.
+ * @return  false if the record ends before, or the varint is too long
+ */
+static U8 readInt(const U8** p, const U8* end, U32* value) {
+    U32 zigzag = 0;
+    U8 shift;
+    for(shift = 0; shift < 35; shift += 7) {
+        U8 byte;
+        if(*p == end) {
+            return 0;
+        }
+        byte = *(*p)++;
+        zigzag |= (U32)(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0) {
+            *value = (zigzag >> 1) ^ (U32)-(S32)(zigzag & 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void printRaw(const Framer_Frame* frame) {
+    USIZE i;
+    printf("<raw");
+    for(i = 0; i < frame->size; i++) {
+        printf(" %02X", frame->data[i]);
+    }
+    printf(">\n");
+}
+
+/**
+ * Print a record with its format: each conversion is given to printf with its argument, the rest of the format is copied.
+ */
+static void printRecord(const Framer_Frame* frame) {
+    const char* f;
+    const U8* arg = frame->data + 1;
+    const U8* end = frame->data + frame->size;
+    char line[1024];
+    size_t len = 0;
+
+    if(frame->size == 0 || frame->data[0] >= FORMAT_NB) {
+        printRaw(frame);
+        return;
+    }
+    for(f = formats[frame->data[0]].format; *f != 0 && len < sizeof(line) - 1; ) {
+        char spec[32];
+        size_t n = 0;
+        if(*f != '%') {
+            line[len++] = *f++;
+            continue;
+        }
+        if(f[1] == '%') {
+            line[len++] = '%';
+            f += 2;
+            continue;
+        }
+        spec[n++] = *f++;
+        while(*f != 0 && strchr("-+ #0123456789.", *f) != null && n < sizeof(spec) - 3) {
+            spec[n++] = *f++;
+        }
+        while(*f != 0 && strchr("hlLqjzt", *f) != null) {   // length modifiers: every argument is 32 bits
+            f++;
+        }
+        if(*f == 0) {
+            printRaw(frame);
+            return;
+        }
+        if(strchr("diouxXc", *f) != null) {
+            U32 value;
+            if(!readInt(&arg, end, &value)) {
+                printRaw(frame);
+                return;
+            }
+            if(*f != 'c') {
+                spec[n++] = 'l';
+            }
+            spec[n++] = *f++;
+            spec[n] = 0;
+            if(spec[n - 1] == 'd' || spec[n - 1] == 'i') {
+                len += snprintf(line + len, sizeof(line) - len, spec, (long)(S32)value);
+            } else if(spec[n - 1] == 'c') {
+                len += snprintf(line + len, sizeof(line) - len, spec, (int)value);
+            } else {
+                len += snprintf(line + len, sizeof(line) - len, spec, (unsigned long)value);
+            }
+        } else if(strchr("fFeEgG", *f) != null) {
+            union {
+                float f;
+                U32 u;
+            } value;
+            if(!readFloat(&arg, end, &value.u)) {
+                printRaw(frame);
+                return;
+            }
+            spec[n++] = *f++;
+            spec[n] = 0;
+            len += snprintf(line + len, sizeof(line) - len, spec, (double)value.f);
+        } else {
+            printRaw(frame);
+            return;
+        }
+        if(len > sizeof(line) - 1) {
+            len = sizeof(line) - 1;
+        }
+    }
+    line[len] = 0;
+    if(arg != end) {
+        printRaw(frame);
+        return;
+    }
+    printf("%s\n", line);
+}
+
+int main(void) {
+    ObjectFIFO frames = ObjectFIFO_new(1 << 16);
+    Framer framer = Framer_new(1 + 255 * 4, frames);
+    Framer_Stats stats;
+    U8 buffer[4096];
+    ssize_t n;
+
+    for(;;) {
+        Framer_Frame* frame;
+        n = read(0, buffer, sizeof(buffer));    // returns what is there, without waiting for a full buffer: the messages of a slow line are printed as they come
+        if(n < 0 && errno == EINTR) {
+            continue;
+        }
+        if(n <= 0) {
+            break;
+        }
+        Framer_decodeBytes(framer, buffer, n);
+        while((frame = ObjectFIFO_borrow(frames)) != null) {
+            printRecord(frame);
+            ObjectFIFO_release(frames);
+        }
+        fflush(stdout);
+    }
+    Framer_getStats(framer, &stats);
+    fprintf(stderr, "%lu records, %lu damaged frames\n", (unsigned long)stats.framesDecoded, (unsigned long)(stats.crcErrors + stats.formatErrors));
+    return 0;
+}
@@ -0,0 +1,231 @@
+/** @file       test_format.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host test and benchmark of Format (algos/Format.c), against the printf of the C library.
+ *      gcc -O2 -std=gnu99 -fgnu89-inline -I. -Ialgos/lists -include stddef.h -o test_format tools/test_format.c algos/Format.c algos/lists/ByteFIFO.c -lm
+ *      ./test_format [-b]
+ *  The floats are compared with snprintf("%.*f") at 0 to Format_MAX_DECIMALS decimals, and parsed back (round trip within half a unit of the last decimal).
+ *  The ring pointers are moved between the tests, so that the texts are written across the end of the array.
+ *  With -b, it also prints the time per call of Format and of sprintf (host numbers: on the dsPIC, sprintf also pays the soft-float and 32 bits division routines).
+ *  Prints OK, or the first failed check (and returns 1).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "../typedef.h"
+#include "../algos/Format.h"
+
+#define CHECK(cond)     do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while(0)
+
+static ByteFIFO fifo;
+static char text[512];
+static char ref[512];
+
+static U32 random32(void) {    // xorshift: the same sequence on every host
+    static U32 s = 12345;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+static float randomFloat(void) {
+    union {
+        U32 u;
+        float f;
+    } bits;
+    switch(random32() % 4) {
+        case 0:     // any bits: nan, inf, subnormals...
+            bits.u = random32();
+            return bits.f;
+        case 1:     // around 2 decimals
+            return (float)((S32)random32() % 2000000) / 100.0f;
+        case 2:     // exact ties
+            return ((S32)(random32() % 20001) - 10000) * 0.125f / (1 << (random32() % 8));
+        default:
+            return ((float)random32() / 4294967296.0f - 0.5f) * powf(10, (int)(random32() % 14) - 7);
+    }
+}
+
+/**
+ * Move the ring pointers of the FIFO (which is empty).
+ */
+static void moveRing(void) {
+    ByteFIFO_pushBlock(fifo, random32() % 250, ref);
+    ByteFIFO_popAvailable(fifo, sizeof(ref), ref);
+}
+
+/**
+ * Pop the text written in the FIFO.
+ */
+static void takeText(void) {
+    USIZE n = ByteFIFO_popAvailable(fifo, sizeof(text) - 1, text);
+    text[n] = 0;
+}
+
+static void testFloats(void) {
+    U32 i;
+    for(i = 0; i < 1000000; i++) {
+        const float x = randomFloat();
+        const U8 decimals = random32() % (Format_MAX_DECIMALS + 1);
+        moveRing();
+        CHECK(Format_pushFloat(fifo, x, decimals) == ByteFIFO_OK);
+        takeText();
+        if(fabsf(x) >= 4294967296.0f && !isinf(x)) {
+            CHECK(strcmp(text + (text[0] == '-'), "ovf") == 0);
+            continue;
+        }
+        snprintf(ref, sizeof(ref), "%.*f", decimals, (double)x);
+        if(strcmp(text, ref) != 0) {
+            printf("%.9g at %u decimals: '%s' instead of '%s'\n", (double)x, decimals, text, ref);
+            exit(1);
+        }
+        if(!isnan(x) && !isinf(x)) {
+            CHECK(fabs(strtod(text, null) - (double)x) <= 0.5 * pow(10, -decimals) * (1 + 1e-9) + fabs(x) * 1e-15);
+        }
+    }
+}
+
+static void testIntegers(void) {
+    U32 i;
+    for(i = 0; i < 1000000; i++) {
+        const S32 value = (S32)random32() >> (random32() % 32);
+        const U32 uvalue = random32() >> (random32() % 32);
+        moveRing();
+        CHECK(Format_pushInt(fifo, value) == ByteFIFO_OK);
+        takeText();
+        snprintf(ref, sizeof(ref), "%ld", (long)value);
+        CHECK(strcmp(text, ref) == 0);
+        CHECK(Format_pushUInt(fifo, uvalue) == ByteFIFO_OK);
+        takeText();
+        snprintf(ref, sizeof(ref), "%lu", (unsigned long)uvalue);
+        CHECK(strcmp(text, ref) == 0);
+    }
+    Format_pushInt(fifo, (S32)0x80000000UL);
+    takeText();
+    CHECK(strcmp(text, "-2147483648") == 0);
+}
+
+static void testPrint(void) {
+    U32 i;
+    for(i = 0; i < 200000; i++) {
+        const S32 a = (S32)random32() >> (random32() % 32);
+        const unsigned long u = (U32)a;
+        const float x = randomFloat();
+        const float y = randomFloat();
+        if(fabsf(x) >= 4294967296.0f || fabsf(y) >= 4294967296.0f) {
+            continue;
+        }
+        moveRing();
+        switch(i % 4) {
+            case 0:
+                Format_print(fifo, "%d|%5d|%-5d|%05d", (int)a, (int)a, (int)a, (int)a);
+                snprintf(ref, sizeof(ref), "%d|%5d|%-5d|%05d", (int)a, (int)a, (int)a, (int)a);
+                break;
+            case 1:
+                Format_print(fifo, "%lu %lx %lX %08lx", u, u, u, u);
+                snprintf(ref, sizeof(ref), "%lu %lx %lX %08lx", u, u, u, u);
+                break;
+            case 2:
+                Format_print(fifo, "%c%s%%%-6s|%6s", 'x', "ab", "cd", "ef");
+                snprintf(ref, sizeof(ref), "%c%s%%%-6s|%6s", 'x', "ab", "cd", "ef");
+                break;
+            default:
+                Format_print(fifo, "%.2f %8.3f %-8.1f| %08.2f %.0f %f", x, y, x, y, x, y);
+                snprintf(ref, sizeof(ref), "%.2f %8.3f %-8.1f| %08.2f %.0f %f", (double)x, (double)y, (double)x, (double)y, (double)x, (double)y);
+                break;
+        }
+        takeText();
+        if(strcmp(text, ref) != 0) {
+            printf("'%s' instead of '%s'\n", text, ref);
+            exit(1);
+        }
+    }
+}
+
+/**
+ * A text that does not fit is not written at all.
+ */
+static void testFull(void) {
+    ByteFIFO_clear(fifo);
+    ByteFIFO_pushBlock(fifo, ByteFIFO_getAvailableSize(fifo) - 10, ref);
+    CHECK(Format_print(fifo, "%.2f,%.2f,%.2f", 1.5, 2.5, 3.5) == ByteFIFO_FULL);
+    CHECK(ByteFIFO_getAvailableSize(fifo) == 10);
+    CHECK(Format_print(fifo, "%.2f,%.2f", 1.5, 2.5) == ByteFIFO_OK);
+    CHECK(ByteFIFO_getAvailableSize(fifo) == 1);
+    ByteFIFO_clear(fifo);
+}
+
+static double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void benchmark(void) {
+    static const char matrix[] = "m = [%.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f ; %.2f,%.2f,%.2f,%.2f]\r\n";
+    float m[16];
+    double t;
+    U32 i;
+    for(i = 0; i < 16; i++) {
+        m[i] = ((S32)(random32() % 200000) - 100000) / 1000.0f;
+    }
+    t = now();
+    for(i = 0; i < 200000; i++) {
+        Format_print(fifo, matrix, m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9], m[10], m[11], m[12], m[13], m[14], m[15]);
+        ByteFIFO_clear(fifo);
+    }
+    printf("matrix44 line:  Format_print     %6.0f ns", (now() - t) / 200000 * 1e9);
+    t = now();
+    for(i = 0; i < 200000; i++) {
+        sprintf(ref, matrix, m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9], m[10], m[11], m[12], m[13], m[14], m[15]);
+        ByteFIFO_pushStr(fifo, ref);
+        ByteFIFO_clear(fifo);
+    }
+    printf("    sprintf+pushStr %6.0f ns\n", (now() - t) / 200000 * 1e9);
+    t = now();
+    for(i = 0; i < 1000000; i++) {
+        Format_pushFloat(fifo, m[i & 15], 2);
+        ByteFIFO_clear(fifo);
+    }
+    printf("%%.2f:           Format_pushFloat %6.0f ns", (now() - t) / 1000000 * 1e9);
+    t = now();
+    for(i = 0; i < 1000000; i++) {
+        sprintf(ref, "%.2f", m[i & 15]);
+        ByteFIFO_pushStr(fifo, ref);
+        ByteFIFO_clear(fifo);
+    }
+    printf("    sprintf+pushStr %6.0f ns\n", (now() - t) / 1000000 * 1e9);
+    t = now();
+    for(i = 0; i < 1000000; i++) {
+        Format_pushInt(fifo, (S32)(i * 7919));
+        ByteFIFO_clear(fifo);
+    }
+    printf("%%ld:            Format_pushInt   %6.0f ns", (now() - t) / 1000000 * 1e9);
+    t = now();
+    for(i = 0; i < 1000000; i++) {
+        sprintf(ref, "%ld", (long)(S32)(i * 7919));
+        ByteFIFO_pushStr(fifo, ref);
+        ByteFIFO_clear(fifo);
+    }
+    printf("    sprintf+pushStr %6.0f ns\n", (now() - t) / 1000000 * 1e9);
+}
+
+int main(int argc, char** argv) {
+    fifo = ByteFIFO_new(300);
+    CHECK(fifo != null);
+    testFloats();
+    testIntegers();
+    testPrint();
+    testFull();
+    if(argc > 1 && strcmp(argv[1], "-b") == 0) {
+        benchmark();
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,253 @@
+/** @file       test_large_sizes.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host test of the containers beyond 64 KiB: on a PC, USIZE is 32 bits (typedef.h), so that the sizes, indices and counts are no longer limited to 65535.
+ *  Each container is filled well past 65536 bytes or elements, across the end of its array for the rings, and its content is checked.
+ *      gcc -O2 -std=gnu99 -fgnu89-inline -I. -Ialgos/lists -include stddef.h -o test_large_sizes tools/test_large_sizes.c algos/lists/ByteFIFO.c algos/lists/ByteLIFO.c algos/lists/MirrorFIFO.c algos/lists/ObjectFIFO.c algos/lists/ObjectLIFO.c algos/lists/HashMap.c algos/lists/PriorityQueue.c algos/lists/UnrolledList.c algos/lists/BlockPool.c algos/lists/IntrusiveList.c
+ *      ./test_large_sizes
+ *  Prints OK, or the first failed check (and returns 1).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../typedef.h"
+#include "../algos/lists/ByteFIFO.h"
+#include "../algos/lists/ByteLIFO.h"
+#include "../algos/lists/MirrorFIFO.h"
+#include "../algos/lists/ObjectFIFO.h"
+#include "../algos/lists/ObjectLIFO.h"
+#include "../algos/lists/HashMap.h"
+#include "../algos/lists/PriorityQueue.h"
+#include "../algos/lists/UnrolledList.h"
+#include "../algos/lists/BlockPool.h"
+#include "../algos/lists/IntrusiveList.h"
+#include "../algos/lists/TypedFIFO.h"
+
+#define CHECK(cond)     do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while(0)
+
+#define BIG             (3UL << 20)
+
+TYPEDFIFO_DECLARE(U32FIFO, U32)
+TYPEDFIFO_DEFINE(U32FIFO, U32)
+
+static U8* source;
+static U8* dest;
+
+static void testByteFIFO(void) {
+    ByteFIFO fifo = ByteFIFO_new(BIG);
+    CHECK(fifo != null);
+    CHECK(ByteFIFO_pushBlock(fifo, 100000, source) == ByteFIFO_OK);
+    CHECK(ByteFIFO_popBlock(fifo, 100000, dest) == ByteFIFO_OK);
+    CHECK(memcmp(source, dest, 100000) == 0);
+    CHECK(ByteFIFO_pushBlock(fifo, BIG, source) == ByteFIFO_OK);    // across the end of the array
+    CHECK(ByteFIFO_getDataSize(fifo) == BIG && ByteFIFO_isFull(fifo));
+    CHECK(ByteFIFO_pushByte(fifo, 0) != ByteFIFO_OK);
+    CHECK(ByteFIFO_popBlock(fifo, BIG, dest) == ByteFIFO_OK);
+    CHECK(memcmp(source, dest, BIG) == 0);
+    ByteFIFO_free(fifo);
+}
+
+static void testByteLIFO(void) {
+    ByteLIFO lifo = ByteLIFO_new(200000);
+    CHECK(lifo != null);
+    CHECK(ByteLIFO_pushBlock(lifo, 150000, source) == 0);
+    CHECK(ByteLIFO_getDataSize(lifo) == 150000 && ByteLIFO_getAvailableSize(lifo) == 50000);
+    CHECK(ByteLIFO_rpopBlock(lifo, 150000, dest) == 0);     // in the order they were pushed
+    CHECK(memcmp(source, dest, 150000) == 0 && ByteLIFO_isEmpty(lifo));
+    ByteLIFO_free(lifo);
+}
+
+static void testMirrorFIFO(void) {
+    MirrorFIFO fifo = MirrorFIFO_new(BIG);
+    CHECK(fifo != null);
+    CHECK(MirrorFIFO_pushBlock(fifo, 100000, source) == ByteFIFO_OK);
+    CHECK(MirrorFIFO_popBlock(fifo, 100000, dest) == ByteFIFO_OK);
+    CHECK(MirrorFIFO_pushBlock(fifo, BIG, source) == ByteFIFO_OK);
+    CHECK(MirrorFIFO_getDataSize(fifo) == BIG);
+    CHECK(memcmp(MirrorFIFO_getReadPtr(fifo), source, BIG) == 0);     // contiguous, even across the end
+    MirrorFIFO_skip(fifo, BIG);
+    CHECK(MirrorFIFO_isEmpty(fifo));
+    MirrorFIFO_free(fifo);
+}
+
+static void testObjectFIFO(void) {
+    ObjectFIFO fifo = ObjectFIFO_new(1000000);
+    USIZE nb = 0, i;
+    U8* data;
+    CHECK(fifo != null);
+    while((data = ObjectFIFO_push(fifo, 7, &nb)) != null) {
+        CHECK((uintptr_t)data % sizeof(USIZE) == 0);
+        nb++;
+    }
+    CHECK(nb > 65536 && ObjectFIFO_getObjectNb(fifo) == nb);
+    for(i = 0; i < nb / 2; i++) {
+        USIZE value;
+        data = ObjectFIFO_pop(fifo);
+        CHECK(data != null);
+        memcpy(&value, data, sizeof(USIZE));
+        CHECK(value == i);
+    }
+    for(i = 0; i < 1000; i++) {     // across the end of the array
+        CHECK(ObjectFIFO_push(fifo, 100, source) != null);
+    }
+    CHECK(ObjectFIFO_getObjectNb(fifo) == nb - nb / 2 + 1000);
+    ObjectFIFO_free(fifo);
+}
+
+static void testObjectLIFO(void) {
+    ObjectLIFO lifo = ObjectLIFO_new(2000000);
+    USIZE nb = 0;
+    U8* data;
+    CHECK(lifo != null);
+    while((data = ObjectLIFO_push(lifo, 5, &nb)) != null) {
+        CHECK((uintptr_t)data % sizeof(void*) == 0);
+        nb++;
+    }
+    CHECK(nb > 65536 && ObjectLIFO_getObjectNb(lifo) == nb);
+    while(nb-- > 0) {
+        USIZE value;
+        data = ObjectLIFO_pop(lifo);
+        CHECK(data != null);
+        memcpy(&value, data, sizeof(USIZE));
+        CHECK(value == nb);
+    }
+    CHECK(ObjectLIFO_isEmpty(lifo));
+    ObjectLIFO_free(lifo);
+}
+
+static U8 isSmaller(void* a, void* b) {
+    return (uintptr_t)a < (uintptr_t)b;
+}
+
+static void testHashMapPriorityQueue(void) {
+    HashMap map = HashMap_new(300000);
+    PriorityQueue queue = PriorityQueue_new(100000, isSmaller);
+    uintptr_t i;
+    CHECK(map != null && queue != null);
+    CHECK(HashMap_getCapacity(map) == 524288);
+    for(i = 1; i <= 200000; i++) {
+        CHECK(HashMap_put(map, i * 3, (void*)i) == HashMap_OK);
+    }
+    CHECK(HashMap_getSize(map) == 200000);
+    for(i = 1; i <= 200000; i += 2) {
+        CHECK(HashMap_remove(map, i * 3) == (void*)i);
+    }
+    for(i = 2; i <= 200000; i += 2) {
+        CHECK(HashMap_get(map, i * 3) == (void*)i);
+    }
+    CHECK(HashMap_getSize(map) == 100000);
+    for(i = 0; i < 100000; i++) {
+        CHECK(PriorityQueue_push(queue, (void*)((i * 7919) % 100000 + 1)) == PriorityQueue_OK);
+    }
+    CHECK(PriorityQueue_getSize(queue) == 100000 && PriorityQueue_isFull(queue));
+    for(i = 1; i <= 100000; i++) {
+        CHECK(PriorityQueue_popMin(queue) == (void*)i);
+    }
+    HashMap_free(map);
+    PriorityQueue_free(queue);
+}
+
+static USIZE visited;
+
+static void checkNext(void* data) {
+    CHECK(*(U32*)data == visited);
+    visited++;
+}
+
+static void testUnrolledList(void) {
+    UnrolledList list = UnrolledList_new();
+    U32* values = malloc(100000 * sizeof(U32));
+    USIZE i;
+    CHECK(list != null && values != null);
+    for(i = 0; i < 100000; i++) {
+        values[i] = i;
+        CHECK(UnrolledList_addLast(list, &values[i]) == LINKEDLIST_SUCCESS);
+    }
+    CHECK(UnrolledList_size(list) == 100000);
+    CHECK(*(U32*)UnrolledList_getMiddle(list, 70000) == 70000);
+    visited = 0;
+    UnrolledList_executeAll(list, checkNext);
+    CHECK(visited == 100000);
+    CHECK(*(U32*)UnrolledList_removeMiddle(list, 99999) == 99999);
+    CHECK(UnrolledList_removeAll(list) == 99999);
+    UnrolledList_free(list);
+    free(values);
+}
+
+typedef struct {
+    U32 value;
+    IntrusiveList_node node;
+} Item;
+
+static void testBlockPoolIntrusiveList(void) {
+    BlockPool pool = BlockPool_new(sizeof(Item), 100000);
+    IntrusiveList list = IntrusiveList_new(IntrusiveList_offsetOf(Item, node));
+    Item* item;
+    U32 i;
+    CHECK(pool != null && list != null);
+    CHECK(BlockPool_getFreeNb(pool) == 100000);
+    for(i = 0; i < 100000; i++) {
+        item = BlockPool_alloc(pool);
+        CHECK(item != null);
+        item->value = i;
+        IntrusiveList_addLast(list, item);
+    }
+    CHECK(BlockPool_alloc(pool) == null && BlockPool_getFreeNb(pool) == 0 && BlockPool_getFailNb(pool) == 1);
+    CHECK(IntrusiveList_size(list) == 100000);
+    visited = 0;
+    IntrusiveList_executeAll(list, checkNext);
+    CHECK(visited == 100000);
+    for(i = 0; i < 100000; i++) {
+        item = IntrusiveList_removeFirst(list);
+        CHECK(item != null && item->value == i);
+        BlockPool_release(pool, item);
+    }
+    CHECK(IntrusiveList_isEmpty(list) && BlockPool_getFreeNb(pool) == 100000);
+    IntrusiveList_free(list);
+    BlockPool_free(pool);
+}
+
+static void testTypedFIFO(void) {
+    U32FIFO fifo = U32FIFO_new(200000);
+    U32* values = (U32*)dest;
+    U32 i, value;
+    CHECK(fifo != null);
+    for(i = 0; i < 150000; i++) {
+        CHECK(U32FIFO_push(fifo, i));
+    }
+    for(i = 0; i < 150000; i++) {
+        CHECK(U32FIFO_pop(fifo, &value) && value == i);
+    }
+    CHECK(U32FIFO_pushArray(fifo, 100000, (const U32*)source) == 100000);     // across the end of the array
+    CHECK(U32FIFO_pushArray(fifo, 100000, (const U32*)source) == 100000);
+    CHECK(U32FIFO_getNb(fifo) == 200000 && U32FIFO_isFull(fifo));
+    CHECK(U32FIFO_popArray(fifo, 100000, values) == 100000);
+    CHECK(memcmp(values, source, 100000 * sizeof(U32)) == 0);
+    U32FIFO_free(fifo);
+}
+
+int main(void) {
+    U32 i;
+    CHECK(sizeof(USIZE) == 4);
+    source = malloc(BIG);
+    dest = malloc(BIG);
+    CHECK(source != null && dest != null);
+    for(i = 0; i < BIG; i++) {
+        source[i] = (U8)(i * 31 + i / 251);
+    }
+    testByteFIFO();
+    testByteLIFO();
+    testMirrorFIFO();
+    testObjectFIFO();
+    testObjectLIFO();
+    testHashMapPriorityQueue();
+    testUnrolledList();
+    testBlockPoolIntrusiveList();
+    testTypedFIFO();
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,115 @@
+/** @file       test_objectfifo.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host test of ObjectFIFO (single thread): the sizing rule of ObjectFIFO_new, and the *Overwrite functions.
+ *      gcc -O2 -std=gnu99 -fgnu89-inline -I. -Ialgos/lists -include stddef.h -o test_objectfifo tools/test_objectfifo.c algos/lists/ObjectFIFO.c
+ *      ./test_objectfifo
+ *  Prints OK, or the first failed check (and returns 1).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../typedef.h"
+#include "../algos/lists/ObjectFIFO.h"
+
+#define CHECK(cond)     do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while(0)
+
+/// size of an object in the FIFO, without its header: rounded up to the alignment of the blocks
+#define A(x)            (((x) + sizeof(USIZE) - 1) / sizeof(USIZE) * sizeof(USIZE))
+
+static const char pattern[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+/**
+ * Random pushes and pops: every push allowed by the sizing rule of ObjectFIFO_new must succeed, and the objects must come out intact, in order.
+ */
+static void testSizingRule(void) {
+    unsigned fifoNb;
+    srand(1);
+    for(fifoNb = 0; fifoNb < 2000; fifoNb++) {
+        const USIZE size = 40 + rand() % 400;
+        ObjectFIFO fifo = ObjectFIFO_new(size);
+        USIZE sizes[256];
+        unsigned first = 0, nb = 0, op;
+        CHECK(fifo != null);
+        for(op = 0; op < 5000; op++) {
+            USIZE s, sum, max, j;
+            if(nb > 0 && rand() % 3 == 0) {
+                U8* data = ObjectFIFO_pop(fifo);
+                CHECK(data != null && memcmp(data, pattern + first % 8, sizes[first % 256]) == 0);
+                first++;
+                nb--;
+                continue;
+            }
+            s = rand() % 40;
+            sum = A(s);
+            max = A(s);
+            for(j = 0; j < nb; j++) {
+                const USIZE a = A(sizes[(first + j) % 256]);
+                sum += a;
+                max = a > max ? a : max;
+            }
+            if(ObjectFIFO_push(fifo, s, pattern + (first + nb) % 8) != null) {
+                sizes[(first + nb) % 256] = s;
+                nb++;
+            } else {
+                CHECK((nb + 2) * sizeof(ObjectFIFO_Elem) + sum + max > size);
+            }
+        }
+        CHECK(ObjectFIFO_getDroppedNb(fifo) == 0);
+        ObjectFIFO_free(fifo);
+    }
+}
+
+/**
+ * ObjectFIFO_pushOverwrite on an empty FIFO, with an object that fits neither after write nor before it: the FIFO must restart at the beginning of its array.
+ */
+static void testOverwriteEmpty(void) {
+    ObjectFIFO fifo = ObjectFIFO_new(64);
+    U8* data;
+    CHECK(ObjectFIFO_push(fifo, 28, pattern) != null);
+    CHECK(ObjectFIFO_pop(fifo) != null);
+    CHECK(ObjectFIFO_push(fifo, 40, pattern) == null);     // claim may refuse it, the FIFO being used by a reader
+    CHECK(ObjectFIFO_pushOverwrite(fifo, 40, pattern) != null);
+    CHECK(ObjectFIFO_getDroppedNb(fifo) == 0);
+    data = ObjectFIFO_pop(fifo);
+    CHECK(data != null && memcmp(data, pattern, 40) == 0);
+    CHECK(ObjectFIFO_isEmpty(fifo));
+    CHECK(ObjectFIFO_pushOverwrite(fifo, 64, pattern) == null);    // too big, even for an empty FIFO
+    ObjectFIFO_free(fifo);
+}
+
+/**
+ * ObjectFIFO_pushOverwrite on a full FIFO: the oldest objects are dropped, the newest ones are kept in order.
+ */
+static void testOverwriteRing(void) {
+    ObjectFIFO fifo = ObjectFIFO_new(200);
+    U32 i, next = 0;
+    srand(2);
+    for(i = 0; i < 100000; i++) {
+        U8 object[40];
+        const USIZE size = sizeof(U32) + rand() % (sizeof(object) - sizeof(U32));
+        memcpy(object, &i, sizeof(U32));
+        CHECK(ObjectFIFO_pushOverwrite(fifo, size, object) != null);
+        if(rand() % 4 == 0) {
+            U8* data = ObjectFIFO_pop(fifo);
+            U32 value;
+            CHECK(data != null);
+            memcpy(&value, data, sizeof(U32));
+            CHECK(value >= next && value <= i);
+            next = value + 1;
+        }
+    }
+    CHECK(ObjectFIFO_getDroppedNb(fifo) > 0);
+    ObjectFIFO_free(fifo);
+}
+
+int main(void) {
+    testSizingRule();
+    testOverwriteEmpty();
+    testOverwriteRing();
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,109 @@
+/** @file       test_objectfifo_spsc.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host stress test of ObjectFIFO used by one writer and one reader at the same time (ObjectFIFO_claim/publish/publishSize in a thread, ObjectFIFO_borrow/release in an other),
+ *  as a main loop and an interrupt would on the dsPIC, but with true concurrency and the memory ordering of the host.
+ *  The objects have various sizes, so that the writer wraps at every position of the array. Each one carries its number and its size, and is filled with bytes derived from them:
+ *  the reader checks that it gets every object once, in order, and intact.
+ *  One object in three is claimed bigger than half of the FIFO, then shrunk: even empty, the FIFO may refuse it (see ObjectFIFO_new), the writer then claims its exact size.
+ *      gcc -O2 -std=gnu99 -fgnu89-inline -pthread -I. -Ialgos/lists -include stddef.h -o test_objectfifo_spsc tools/test_objectfifo_spsc.c algos/lists/ObjectFIFO.c
+ *      ./test_objectfifo_spsc
+ *  Prints OK, or the first failed check (and returns 1).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../typedef.h"
+#include "../algos/lists/ObjectFIFO.h"
+
+#define CHECK(cond)     do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while(0)
+
+#define OBJECT_NB       1000000
+#define MAX_SIZE        80
+
+typedef struct {
+    U32 number;
+    U32 size;
+    U8 bytes[MAX_SIZE - 2 * sizeof(U32)];
+} Object;
+
+static ObjectFIFO fifo;
+static USIZE bigClaim;     // more than half of the FIFO
+
+static U32 sizeOf(U32 number) {
+    return 2 * sizeof(U32) + (number * 7 + number / 13) % (MAX_SIZE - 2 * sizeof(U32) + 1);
+}
+
+static U8 byteOf(U32 number, U32 i) {
+    return (U8)(number * 31 + i * 17);
+}
+
+/**
+ * Writer: one object in three is claimed with bigClaim bytes and shrunk by ObjectFIFO_publishSize.
+ */
+static void* writer(void* unused) {
+    U32 number;
+    (void)unused;
+    for(number = 0; number < OBJECT_NB; number++) {
+        const U32 size = sizeOf(number);
+        U8 shrink = number % 3 == 0;
+        Object* object;
+        U32 i;
+        while((object = ObjectFIFO_claim(fifo, shrink ? bigClaim : size)) == null) {
+            if(shrink && ObjectFIFO_isEmpty(fifo)) {
+                shrink = 0;
+            } else {
+                sched_yield();  // full: let the reader run (the host may have a single CPU)
+            }
+        }
+        object->number = number;
+        object->size = size;
+        for(i = 0; i < size - 2 * sizeof(U32); i++) {
+            object->bytes[i] = byteOf(number, i);
+        }
+        if(shrink) {
+            ObjectFIFO_publishSize(fifo, size);
+        } else {
+            ObjectFIFO_publish(fifo);
+        }
+    }
+    return null;
+}
+
+static void run(const USIZE size) {
+    pthread_t thread;
+    U32 number;
+    fifo = ObjectFIFO_new(size);
+    CHECK(fifo != null);
+    bigClaim = size / 2 + 8;
+    CHECK(pthread_create(&thread, null, writer, null) == 0);
+    for(number = 0; number < OBJECT_NB; number++) {
+        const Object* object;
+        U32 i;
+        while((object = ObjectFIFO_borrow(fifo)) == null) {
+            sched_yield();  // empty: let the writer run
+        }
+        CHECK(object->number == number);
+        CHECK(object->size == sizeOf(number));
+        for(i = 0; i < object->size - 2 * sizeof(U32); i++) {
+            CHECK(object->bytes[i] == byteOf(number, i));
+        }
+        ObjectFIFO_release(fifo);
+    }
+    CHECK(pthread_join(thread, null) == 0);
+    CHECK(ObjectFIFO_isEmpty(fifo));
+    CHECK(ObjectFIFO_borrow(fifo) == null);
+    ObjectFIFO_free(fifo);
+}
+
+int main(void) {
+    run(2 * sizeof(ObjectFIFO_Elem) + 2 * MAX_SIZE);   // the smallest size allowed for an object of MAX_SIZE bytes
+    run(1001);
+    printf("OK\n");
+    return 0;
+}
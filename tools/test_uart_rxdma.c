@@ -0,0 +1,83 @@
+/** @file       test_uart_rxdma.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host test of the DMA reception of UART1 (UART1_initRxDMA, UART1_flushRxDMA), on the dsPIC model of sim/.
+ *  Messages of various lengths separated by idle gaps, with UART1_flushRxDMA polled as a receive timeout: every byte must be handed over, in order,
+ *  with a consumer or through the receive buffer, and also while the DMA of the transmission is busy (it does the last transfers between the messages).
+ *      gcc -O2 -std=gnu99 -fgnu89-inline -Isim -I. -o test_uart_rxdma tools/test_uart_rxdma.c sim/dsPICsim.c modules/UART.c modules/UART1.c modules/UART2.c algos/lists/ByteFIFO.c algos/lists/ObjectFIFO.c algos/Framer.c algos/CRC.c algos/Format.c -lm
+ *      ./test_uart_rxdma
+ *  Prints OK, or the first failed check (and returns 1).
+*/
+
+#include <p33Fxxxx.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../typedef.h"
+#include "../modules/UART1.h"
+#include "../modules/DMA.h"
+#include "../sim/dsPICsim.h"
+
+#define CHECK(cond)     do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while(0)
+
+UART1_setU1TXInterruptForMe();
+UART1_setU1RXInterruptForMe();
+UART1_setRxDMAInterruptForMe(1);
+UART1_setTxDMAInterruptForMe(2);
+
+static U8 sent[10000];
+static U8 received[sizeof(sent)];
+static U32 receivedNb;
+
+static void consume(const void* data, U16 size) {
+    CHECK(receivedNb + size <= sizeof(received));
+    memcpy(received + receivedNb, data, size);
+    receivedNb += size;
+}
+
+static void run(void (*consumer)(const void*, U16), U32 baudrate, U8 withTx) {
+    U32 i, k;
+    sim_reset();
+    receivedNb = 0;
+    CHECK(UART1_init(5, 512, 5, 6, 2000, 4, baudrate, 7) == UART_OK);
+    CHECK(UART1_initRxDMA(1, 5, DMA_RAM_BASE + 0x200, 64, consumer) == UART_OK);
+    if(withTx) {
+        CHECK(UART1_initTxDMA(2, 5, DMA_RAM_BASE + 0x400, 300) == UART_OK);
+    }
+    for(i = 0; i < sizeof(sent); ) {
+        U32 size = 1 + (i * 37) % 150;
+        if(i + size > sizeof(sent)) {
+            size = sizeof(sent) - i;
+        }
+        sim_uartReceive(1, sent + i, size);
+        if(withTx) {
+            UART1_sendTab(sent, 50);
+        }
+        for(k = 0; k < size + 6; k += 2) {     // receive timeout of 2 characters
+            sim_run(sim_uartGetCharCycles(1) * 2);
+            UART1_flushRxDMA();
+            if(consumer == null) {
+                receivedNb += UART1_readAvailable(received + receivedNb, sizeof(received) - receivedNb);
+            }
+        }
+        i += size;
+    }
+    CHECK(receivedNb == sizeof(sent) && memcmp(received, sent, sizeof(sent)) == 0);
+    CHECK(sim_uartGetLostNb(1) == 0);
+}
+
+int main(void) {
+    U32 i;
+    for(i = 0; i < sizeof(sent); i++) {     // every byte value, 0xFF included
+        sent[i] = (U8) (i * 13 + 7);
+    }
+    run(consume, 115200, 0);
+    run(null, 115200, 0);
+    run(consume, 2000000, 0);
+    run(consume, 115200, 1);
+    run(null, 2000000, 1);
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+/** @file       test_unrolledlist.c
+ *  @author     ogbwJtHRXkd5H3z1RIrW2zOo
+ *  @version    1.0
+ *  @date       19/10/2026
+ *
+ *  Host test of UnrolledList: random insertions and removals compared with an array, and the chunks checked after each removeIf/deleteIf.
+ *      gcc -O2 -std=gnu99 -fgnu89-inline -I. -Ialgos/lists -include stddef.h -o test_unrolledlist tools/test_unrolledlist.c algos/lists/UnrolledList.c
+ *      ./test_unrolledlist
+ *  Prints OK, or the first failed check (and returns 1).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../typedef.h"
+#include "../algos/lists/UnrolledList.h"
+
+#define CHECK(cond)     do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while(0)
+
+#define MAX_NB          3000
+
+static int values[MAX_NB];
+static int model[MAX_NB];      // what the list must contain, in order
+static USIZE modelNb;
+static USIZE visited;
+static int divisor;             // removeIf/deleteIf remove the values multiple of divisor (none if 0)
+
+static U8 isMultiple(void* data) {
+    return divisor != 0 && *(int*)data % divisor == 0;
+}
+
+static void checkNext(void* data) {
+    CHECK(visited < modelNb && *(int*)data == model[visited]);
+    visited++;
+}
+
+/**
+ * Compare the list with the model: traversal, chunks, and links.
+ */
+static void verify(const UnrolledList list) {
+    UnrolledList_chunk* chunk;
+    USIZE nb = 0;
+    CHECK(UnrolledList_size(list) == modelNb);
+    visited = 0;
+    UnrolledList_executeAll(list, checkNext);
+    CHECK(visited == modelNb);
+    for(chunk = list->first; chunk != null; chunk = chunk->next) {
+        CHECK(chunk->nb > 0 && chunk->nb <= UNROLLEDLIST_CHUNK_SIZE);
+        CHECK(chunk->next != null ? chunk->next->prev == chunk : list->last == chunk);
+        nb += chunk->nb;
+    }
+    CHECK(nb == modelNb);
+    CHECK((list->first == null) == (modelNb == 0));
+}
+
+static USIZE removeFromModel(void) {
+    USIZE i, kept = 0;
+    for(i = 0; i < modelNb; i++) {
+        if(divisor == 0 || model[i] % divisor != 0) {
+            model[kept++] = model[i];
+        }
+    }
+    i = modelNb - kept;
+    modelNb = kept;
+    return i;
+}
+
+/**
+ * removeIf with no match on partially filled chunks: nothing must be lost nor duplicated.
+ */
+static void testRemoveIfNone(void) {
+    UnrolledList list = UnrolledList_new();
+    USIZE i;
+    modelNb = 0;
+    for(i = 1; i <= 16; i++) {
+        values[i] = i;
+        CHECK(UnrolledList_addLast(list, &values[i]) == LINKEDLIST_SUCCESS);
+    }
+    for(i = 0; i < 4; i++) {
+        UnrolledList_removeFirst(list);
+    }
+    for(i = 5; i <= 16; i++) {
+        model[modelNb++] = i;
+    }
+    divisor = 0;
+    CHECK(UnrolledList_removeIf(list, isMultiple) == 0);
+    verify(list);
+    divisor = 5;
+    CHECK(UnrolledList_removeIf(list, isMultiple) == removeFromModel());
+    verify(list);
+    UnrolledList_free(list);
+}
+
+/**
+ * Random operations. The elements are malloc'ed, so that deleteIf frees them (a duplicated element would be freed twice).
+ */
+static void testRandom(void) {
+    UnrolledList list = UnrolledList_new();
+    USIZE i, op;
+    modelNb = 0;
+    srand(1);
+    for(op = 0; op < 20000; op++) {
+        const int kind = rand() % 8;
+        USIZE index = modelNb != 0 ? rand() % (modelNb + 1) : 0;
+        if(kind < 5 && modelNb < MAX_NB) {
+            int* data = malloc(sizeof(int));
+            *data = rand() % 1000;
+            CHECK(UnrolledList_addMiddle(list, data, index) == LINKEDLIST_SUCCESS);
+            for(i = modelNb; i > index; i--) {
+                model[i] = model[i - 1];
+            }
+            model[index] = *data;
+            modelNb++;
+        } else if(kind == 5 && modelNb != 0) {
+            int* data;
+            index %= modelNb;
+            data = UnrolledList_removeMiddle(list, index);
+            CHECK(*data == model[index]);
+            free(data);
+            for(i = index; i + 1 < modelNb; i++) {
+                model[i] = model[i + 1];
+            }
+            modelNb--;
+        } else if(kind == 6) {
+            divisor = rand() % 4 == 0 ? 0 : 2 + rand() % 20;
+            CHECK(UnrolledList_deleteIf(list, isMultiple) == removeFromModel());
+            verify(list);
+        }
+    }
+    verify(list);
+    CHECK(UnrolledList_deleteAll(list) == modelNb);
+    modelNb = 0;
+    verify(list);
+    UnrolledList_free(list);
+}
+
+int main(void) {
+    testRemoveIfNone();
+    testRandom();
+    printf("OK\n");
+    return 0;
+}
@@ -1 +1 @@
-/** * @file typedef.h * Define some types in order to make more obvious how many bytes each type takes.*/#ifndef TYPEDEF_H#define TYPEDEF_H#define null ((void*)0)#define false 0;#define true 1typedef char bool;typedef char S8;typedef unsigned char U8;typedef short S16;typedef unsigned short U16;typedef long S32;typedef unsigned long U32;#endif // TYPEDEF_H
\ No newline at end of file
+/** * @file typedef.h * Define some types in order to make more obvious how many bytes each type takes.*/#ifndef TYPEDEF_H#define TYPEDEF_H#define null ((void*)0)#define false 0;#define true 1typedef char bool;typedef char S8;typedef unsigned char U8;typedef short S16;typedef unsigned short U16;#if defined(__XC16__) || defined(__C30__)typedef long S32;typedef unsigned long U32;#else// on a 64 bits host, long is 64 bits wide#include <stdint.h>typedef int32_t S32;typedef uint32_t U32;#endif/** * Type of the sizes and indices of the containers (ByteFIFO, ByteLIFO, ObjectFIFO, ObjectLIFO). * On the dsPIC, it is 16 bits wide: the RAM is far below 64 KiB, and 16 bits accesses are atomic. Define OGBWLIB_LARGE_SIZE to get 32 bits anyway (e.g. for EDS buffers), but then the lock-free ObjectFIFO claim/publish/borrow/release API needs interrupt protection. * On a host, it is 32 bits wide, so that buffers can exceed 64 KiB. */#if (defined(__XC16__) || defined(__C30__)) && !defined(OGBWLIB_LARGE_SIZE)typedef U16 USIZE;#elsetypedef U32 USIZE;#endif#endif // TYPEDEF_H
\ No newline at end of file